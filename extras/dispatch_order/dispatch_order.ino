@@ -0,0 +1,123 @@
+/**
+ * Dispatch order check: guard conditions of every priority class, all triggered before every spin,
+ * so that the executor has all of them ready at once, round after round.
+ * Their callbacks record the order of dispatch, which must follow the priority classes,
+ * and the attach order within a class, see @see{Priority}.
+ *
+ * Flash it with an agent running, then echo the result topic:
+ *   ros2 topic echo /dispatch_order/result
+ * The built-in LED lights up on the first round dispatched out of order.
+*/
+#include <micro_ros_arduino.h>
+#include <std_msgs/msg/string.h>
+
+#include <rclc_cppb.hpp>
+
+using namespace rclc_cppb;
+
+static constexpr size_t GUARD_COUNT = 8;
+static constexpr unsigned long ROUND_COUNT = 1000;
+
+// Attached in this order, so that the classes are out of order and each of them holds two guard conditions
+static constexpr Priority PRIORITIES[GUARD_COUNT] = {
+  Priority::LOW, Priority::CRITICAL, Priority::NORMAL, Priority::HIGH,
+  Priority::LOW, Priority::CRITICAL, Priority::NORMAL, Priority::HIGH
+};
+
+size_t dispatched[GUARD_COUNT];
+size_t dispatched_count = 0;
+unsigned long round_count = 0;
+unsigned long incomplete_count = 0;
+unsigned long out_of_order_count = 0;
+char result[96];
+
+template<size_t INDEX>
+void on_trigger(void)
+{
+  if(dispatched_count < GUARD_COUNT)
+  {
+    dispatched[dispatched_count] = INDEX;
+  }
+  dispatched_count++;
+}
+
+Node node("dispatch_order");
+GuardCondition guards[GUARD_COUNT] = {
+  {&node, on_trigger<0>}, {&node, on_trigger<1>}, {&node, on_trigger<2>}, {&node, on_trigger<3>},
+  {&node, on_trigger<4>}, {&node, on_trigger<5>}, {&node, on_trigger<6>}, {&node, on_trigger<7>}
+};
+Publisher<std_msgs__msg__String> result_publisher(&node, "dispatch_order/result", "");
+
+/**
+ * Checks the dispatches of the last round pair by pair
+ * @return true if none came before one of a higher class, or of the same class but attached earlier
+*/
+bool is_in_order(void)
+{
+  const size_t count = dispatched_count < GUARD_COUNT ? dispatched_count : GUARD_COUNT;
+  for(size_t i = 1; i < count; i++)
+  {
+    const size_t before = dispatched[i - 1];
+    const size_t after = dispatched[i];
+    if(PRIORITIES[before] < PRIORITIES[after] || (PRIORITIES[before] == PRIORITIES[after] && before > after))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void setup()
+{
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LOW);
+
+  node.setup();
+  for(size_t i = 0; i < GUARD_COUNT; i++)
+  {
+    guards[i].set_priority(PRIORITIES[i]);
+    guards[i].attach();
+  }
+  result_publisher.advertise();
+}
+
+void loop()
+{
+  if(round_count == ROUND_COUNT)
+  {
+    result_publisher.publish(result);
+    delay(1000);
+    return;
+  }
+
+  dispatched_count = 0;
+  for(GuardCondition& guard: guards)
+  {
+    guard.trigger();
+  }
+  Node::spin_once(RCL_MS_TO_NS(10));
+
+  if(dispatched_count != GUARD_COUNT)
+  {
+    incomplete_count++;
+  }
+  if(!is_in_order())
+  {
+    out_of_order_count++;
+    digitalWrite(LED_BUILTIN, HIGH);
+  }
+  round_count++;
+
+  if(round_count == ROUND_COUNT)
+  {
+    snprintf(
+      result,
+      sizeof(result),
+      "%s: %lu rounds, %lu out of order, %lu incomplete",
+      out_of_order_count == 0 ? "PASS" : "FAIL",
+      round_count,
+      out_of_order_count,
+      incomplete_count
+    );
+  }
+}
@@ -0,0 +1,81 @@
+/**
+ * Footprint probe: a representative set of entities, whose sizes are read back from the linked firmware
+ * by extras/footprint_report.py. Not meant to be flashed.
+ *
+ * Every entity type gets a constant array as large as the type, named rclc_cppb_sizeof_<label>,
+ * so that its size shows up in the symbol table. The constants live in the probe only:
+ * setup() takes their addresses so that --gc-sections keeps them, and the report subtracts them from flash.
+*/
+#include <micro_ros_arduino.h>
+#include <std_msgs/msg/int32.h>
+#include <std_msgs/msg/string.h>
+#include <std_msgs/msg/float32_multi_array.h>
+#include <std_srvs/srv/empty.h>
+
+#include <rclc_cppb.hpp>
+#include <service_server.hpp>
+#include <service_client.hpp>
+
+using namespace rclc_cppb;
+
+using EmptyServer = ServiceServer<std_msgs__msg__Empty, std_msgs__msg__Empty>;
+using EmptyClient = ServiceClient<std_msgs__msg__Empty, std_msgs__msg__Empty>;
+
+#define FOOTPRINTS(X) \
+  X(Node, Node) \
+  X(Publisher_Int32, Publisher<std_msgs__msg__Int32>) \
+  X(Publisher_String, Publisher<std_msgs__msg__String>) \
+  X(Publisher_Float32MultiArray, Publisher<std_msgs__msg__Float32MultiArray>) \
+  X(Subscriber_Int32, Subscriber<std_msgs__msg__Int32>) \
+  X(Subscriber_String, Subscriber<std_msgs__msg__String>) \
+  X(ServiceServer_Empty, EmptyServer) \
+  X(ServiceClient_Empty, EmptyClient) \
+  X(GuardCondition, GuardCondition) \
+  X(QueuedPublisher_Int32_8, QueuedPublisher<std_msgs__msg__Int32, 8>) \
+  X(RetryingPublisher_Int32_4, RetryingPublisher<std_msgs__msg__Int32, 4>)
+
+#define DEFINE_FOOTPRINT(LABEL, ...) \
+  extern "C" const uint8_t rclc_cppb_sizeof_##LABEL[sizeof(__VA_ARGS__)] = {};
+// Addresses, as the values of the constants are known to the compiler and would not reference them
+#define KEEP_FOOTPRINT(LABEL, ...) \
+  footprint_keeper += (uintptr_t)rclc_cppb_sizeof_##LABEL;
+
+FOOTPRINTS(DEFINE_FOOTPRINT)
+volatile uintptr_t footprint_keeper = 0;
+
+void on_int32(const std_msgs__msg__Int32*) {}
+void on_string(const std_msgs__msg__String*) {}
+void on_request(const std_msgs__msg__Empty*, std_msgs__msg__Empty*) {}
+void on_response(const std_msgs__msg__Empty*) {}
+void on_trigger(void) {}
+
+Node node("footprint");
+Publisher<std_msgs__msg__Int32> int32_publisher(&node, "int32", 0);
+Publisher<std_msgs__msg__String> string_publisher(&node, "string", "");
+Subscriber<std_msgs__msg__Int32> int32_subscriber(&node, "int32_in", on_int32);
+Subscriber<std_msgs__msg__String> string_subscriber(&node, "string_in", on_string);
+EmptyServer server(&node, "server", on_request);
+EmptyClient client(&node, "client", on_response, std_msgs__msg__Empty{});
+GuardCondition guard_condition(&node, on_trigger);
+
+void setup()
+{
+  FOOTPRINTS(KEEP_FOOTPRINT)
+
+  node.setup();
+  int32_publisher.advertise();
+  string_publisher.advertise();
+  int32_subscriber.subscribe();
+  string_subscriber.subscribe();
+  server.advertise();
+  client.attach();
+  guard_condition.attach();
+}
+
+void loop()
+{
+  int32_publisher.publish(1);
+  string_publisher.publish("footprint");
+  client.call();
+  Node::spin_once();
+}
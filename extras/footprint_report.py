@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+Footprint report of rclc_cppb: RAM and flash per entity type, static storage, and linker sections,
+checked against budgets.
+
+Compiles the probe sketch in extras/footprint with arduino-cli, or reads an ELF linked from it,
+then reports:
+- sizeof of every entity type in the probe, i.e. the RAM of one instance including its message storage,
+- flash of every entity type, i.e. the code of its template instantiations,
+- static storage of the library, and of the XRCE middleware, whose buffers are pools preallocated
+  for the maximum amount of entities micro-ROS was built for, whatever the amount in use,
+- sizes of the linker sections.
+
+Exits with status 1 if a budget in extras/footprint/budgets.json (or the one given) is exceeded:
+"ram" bounds .data and .bss, "flash" bounds .text, .rodata and .data less the sizeof constants of the probe,
+"sizeof" bounds each entity type.
+
+Usage:
+  python3 extras/footprint_report.py [--fqbn arduino:mbed_portenta:envie_m7] [--budgets budgets.json]
+  python3 extras/footprint_report.py --elf footprint.ino.elf [--nm arm-none-eabi-nm] [--size arm-none-eabi-size]
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+from collections import defaultdict
+
+from size_report import CODE_TYPES
+
+EXTRAS = os.path.dirname(os.path.abspath(__file__))
+SIZEOF_PREFIX = "rclc_cppb_sizeof_"
+DATA_TYPES = set("dDbBrR")
+RAM_SECTIONS = (".data", ".bss")
+FLASH_SECTIONS = (".text", ".rodata", ".data")
+# Memory pools and buffers of rmw_microxrcedds and Micro XRCE-DDS client
+MIDDLEWARE_PATTERN = re.compile(r"^(custom_\w+|\w+_memory|rmw_uxrce_\w+|uxr_\w+|\w*static_buffer\w*)$")
+
+
+def run(command):
+  return subprocess.run(command, check=True, capture_output=True, text=True).stdout
+
+
+def compile_probe(arduino_cli, fqbn, output_dir):
+  """Compiles the probe sketch, returning the path of its ELF."""
+  sketch = os.path.join(EXTRAS, "footprint")
+  run([arduino_cli, "compile", "--fqbn", fqbn, "--output-dir", output_dir, sketch])
+  return os.path.join(output_dir, "footprint.ino.elf")
+
+
+def read_symbols(nm, path):
+  """Yields (type, size, demangled name) of every symbol with a size."""
+  for line in run([nm, "--demangle", "--print-size", "--radix=d", path]).splitlines():
+    symbol = re.match(r"^\S+ (\d+) (\S) (.*)$", line)
+    if symbol is not None:
+      yield symbol.group(2), int(symbol.group(1)), symbol.group(3)
+
+
+def read_sections(size, path):
+  """Returns the size of every section."""
+  sections = {}
+  for line in run([size, "-A", "-d", path]).splitlines():
+    fields = line.split()
+    if len(fields) >= 2 and fields[0].startswith(".") and fields[1].isdigit():
+      sections[fields[0]] = int(fields[1])
+  return sections
+
+
+def get_section_total(sections, names):
+  """Sums the sections named, or starting with the names followed by a dot, e.g. .bss.ram_d1"""
+  return sum(
+    size
+    for section, size in sections.items()
+    if any(section == name or section.startswith(name + ".") for name in names)
+  )
+
+
+def check(label, used, budget, failures):
+  if budget is None:
+    return "{:>8}".format(used)
+  if used > budget:
+    failures.append("{} is {} bytes, over its budget of {} bytes".format(label, used, budget))
+    return "{:>8} / {:<8} EXCEEDED".format(used, budget)
+  return "{:>8} / {:<8}".format(used, budget)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument("--elf", help="ELF linked from the probe, instead of compiling it")
+  parser.add_argument("--fqbn", default="arduino:mbed_portenta:envie_m7", help="board to compile for (default: %(default)s)")
+  parser.add_argument("--arduino-cli", default="arduino-cli", help="arduino-cli executable (default: %(default)s)")
+  parser.add_argument("--nm", default="arm-none-eabi-nm", help="nm of the toolchain (default: %(default)s)")
+  parser.add_argument("--size", default="arm-none-eabi-size", help="size of the toolchain (default: %(default)s)")
+  parser.add_argument("--budgets", default=os.path.join(EXTRAS, "footprint", "budgets.json"), help="budgets in JSON")
+  arguments = parser.parse_args()
+
+  with open(arguments.budgets) as file:
+    budgets = json.load(file)
+  failures = []
+
+  with tempfile.TemporaryDirectory() as output_dir:
+    try:
+      elf = arguments.elf or compile_probe(arguments.arduino_cli, arguments.fqbn, output_dir)
+      symbols = list(read_symbols(arguments.nm, elf))
+      sections = read_sections(arguments.size, elf)
+    except (OSError, subprocess.CalledProcessError) as error:
+      sys.exit("Could not build or read the probe: {}".format(getattr(error, "stderr", None) or error))
+
+  sizeofs = {name[len(SIZEOF_PREFIX):]: size for _, size, name in symbols if name.startswith(SIZEOF_PREFIX)}
+  if not sizeofs:
+    sys.exit("No {}* symbols found, is this the ELF of extras/footprint?".format(SIZEOF_PREFIX))
+
+  print("RAM per instance (sizeof)")
+  for label, size in sorted(sizeofs.items()):
+    print("  {:<32} {}".format(label, check("sizeof " + label, size, budgets.get("sizeof", {}).get(label), failures)))
+
+  # Code is attributed to the class owning the function, e.g. rclc_cppb::Publisher<std_msgs__msg__Int32>
+  code = defaultdict(int)
+  for type, size, name in symbols:
+    if type in CODE_TYPES and name.startswith("rclc_cppb::"):
+      owner = re.match(r"rclc_cppb::((?:[^:<(]|<[^()]*?>)+)::", name)
+      code[owner.group(1) if owner else "(free functions)"] += size
+  print()
+  print("Flash per type (code)")
+  for owner, size in sorted(code.items(), key=lambda item: item[1], reverse=True):
+    print("  {:<56} {:>8}".format(owner, size))
+
+  library_storage = sum(
+    size for type, size, name in symbols
+    if type in DATA_TYPES and "rclc_cppb" in name and not name.startswith(SIZEOF_PREFIX)
+  )
+  middleware = sorted(
+    ((size, name) for type, size, name in symbols if type in DATA_TYPES and MIDDLEWARE_PATTERN.match(name)),
+    reverse=True
+  )
+  print()
+  print("Static storage")
+  print("  {:<56} {:>8}".format("rclc_cppb", library_storage))
+  print("  {:<56} {:>8}".format("XRCE middleware", sum(size for size, _ in middleware)))
+  for size, name in middleware[:10]:
+    print("    {:<54} {:>8}".format(name, size))
+
+  print()
+  print("Sections")
+  for section, size in sorted(sections.items()):
+    if size > 0:
+      print("  {:<32} {:>8}".format(section, size))
+  ram = get_section_total(sections, RAM_SECTIONS)
+  # The sizeof constants are only there to be measured, not part of the firmware being budgeted
+  flash = get_section_total(sections, FLASH_SECTIONS) - sum(sizeofs.values())
+  print("  {:<32} {}".format("RAM", check("RAM", ram, budgets.get("ram"), failures)))
+  print("  {:<32} {}".format("flash", check("Flash", flash, budgets.get("flash"), failures)))
+
+  if failures:
+    print()
+    for failure in failures:
+      print("Budget exceeded: " + failure, file=sys.stderr)
+    sys.exit(1)
+
+
+if __name__ == "__main__":
+  main()
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""
+Code size report of rclc_cppb, per template instantiation and per template.
+
+Reads the symbol table of a linked firmware, e.g. the .elf left by arduino-cli compile --output-dir,
+then lists the code size of every function of the library, largest first,
+followed by the totals of each template over all of its instantiations.
+Build once with and once without RCLC_CPPB_COMPACT_ERRORS defined to see what it saves.
+
+Usage:
+  python3 extras/size_report.py firmware.elf [--nm arm-none-eabi-nm] [--namespace rclc_cppb] [--top 40]
+"""
+
+import argparse
+import subprocess
+import sys
+from collections import defaultdict
+
+CODE_TYPES = set("tTwW")
+
+
+def strip_template_arguments(name):
+  """Replaces the arguments of every template in a demangled name with <>, keeping the outermost brackets."""
+  result = []
+  depth = 0
+  for character in name:
+    if character == "<":
+      if depth == 0:
+        result.append("<>")
+      depth += 1
+    elif character == ">" and depth > 0:
+      depth -= 1
+    elif depth == 0:
+      result.append(character)
+  return "".join(result)
+
+
+def read_symbols(nm, path):
+  """Yields (size, demangled name) of every code symbol."""
+  output = subprocess.run(
+    [nm, "--demangle", "--print-size", "--size-sort", "--radix=d", path],
+    check=True,
+    capture_output=True,
+    text=True
+  ).stdout
+  for line in output.splitlines():
+    fields = line.split(" ", 3)
+    if len(fields) == 4 and fields[2] in CODE_TYPES:
+      yield int(fields[1]), fields[3]
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument("elf", help="linked firmware or executable")
+  parser.add_argument("--nm", default="arm-none-eabi-nm", help="nm of the toolchain (default: %(default)s)")
+  parser.add_argument("--namespace", default="rclc_cppb", help="namespace to report (default: %(default)s)")
+  parser.add_argument("--top", type=int, default=40, help="amount of instantiations listed (default: %(default)s)")
+  arguments = parser.parse_args()
+
+  try:
+    symbols = [
+      (size, name)
+      for size, name in read_symbols(arguments.nm, arguments.elf)
+      if arguments.namespace + "::" in name
+    ]
+  except (OSError, subprocess.CalledProcessError) as error:
+    sys.exit("Could not read symbols: {}".format(error))
+
+  symbols.sort(reverse=True)
+  print("{:>8}  {}".format("bytes", "instantiation"))
+  for size, name in symbols[:arguments.top]:
+    print("{:>8}  {}".format(size, name))
+  if len(symbols) > arguments.top:
+    print("{:>8}  ... {} more".format("", len(symbols) - arguments.top))
+
+  templates = defaultdict(lambda: [0, 0])
+  for size, name in symbols:
+    template = templates[strip_template_arguments(name)]
+    template[0] += size
+    template[1] += 1
+  print()
+  print("{:>8}  {:>5}  {}".format("bytes", "count", "template"))
+  for name, (size, count) in sorted(templates.items(), key=lambda item: item[1][0], reverse=True):
+    if count > 1 and "<>" in name:
+      print("{:>8}  {:>5}  {}".format(size, count, name))
+
+  error_size = sum(size for size, name in symbols if "::error::" in name)
+  print()
+  print("Total: {} bytes in {} functions, of which error handling {} bytes".format(
+    sum(size for size, _ in symbols),
+    len(symbols),
+    error_size
+  ))
+
+
+if __name__ == "__main__":
+  main()
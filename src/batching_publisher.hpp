@@ -0,0 +1,162 @@
+#pragma once
+
+#include <micro_ros_arduino.h>
+#include <rcl/rcl.h>
+#include <rcl/error_handling.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+
+#include "message.hpp"
+#include "multi_array.hpp"
+#include "node.hpp"
+#include "publisher.hpp"
+#include "spin_hook.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Publisher which collects samples into one MultiArray message, and publishes them as a single batch.
+   *
+   * Saves the per-message overhead of publishing high-rate samples one by one.
+   * The batch is published when it is full, or when the oldest sample in it has waited for the flush timeout.
+   * The message memory is preallocated within the object, so no heap allocation takes place.
+   *
+   * Usage instructions:
+   * - Instantiate before any node is setup.
+   * - Call advertise() in on_setup-method of node or after node setup is completed.
+   * - Call push() for each sample.
+   * - Spin the node as usual, so that a partial batch is published when the flush timeout expires.
+   * - Element type must have MultiArray trait implemented on it.
+   * - Receive the batches with @see{BatchingSubscriber}.
+   * @param <_ElementType> Element type of samples
+   * @param <BATCH_SIZE> Maximum amount of samples per message
+  */
+  template<typename _ElementType, size_t BATCH_SIZE>
+  class BatchingPublisher: SpinHook
+  {
+    static_assert(MultiArray<_ElementType>::IS_IMPL, "Trait MultiArray must be implemented!");
+    static_assert(BATCH_SIZE > 0, "Batch size must be at least one sample!");
+
+    public:
+      /**
+       * Element type of samples
+      */
+      using ElementType = _ElementType;
+      /**
+       * MultiArray message type carrying the samples
+      */
+      using MessageType = typename MultiArray<ElementType>::MessageType;
+
+      /**
+       * Amount of executor handles needed by this publisher
+      */
+      static constexpr unsigned int HANDLE_COUNT = Publisher<MessageType>::HANDLE_COUNT;
+
+      /**
+       * Label of the single dimension in the layout of each message
+      */
+      static constexpr const char* const DIMENSION_LABEL = "samples";
+    private:
+      /**
+       * Publisher of the batches
+      */
+      Publisher<MessageType> _publisher;
+      /**
+       * Batch message, pointing at the preallocated memory below
+      */
+      MessageType _message;
+      /**
+       * Preallocated sample memory
+      */
+      ElementType _samples[BATCH_SIZE];
+      /**
+       * Preallocated layout dimension
+      */
+      std_msgs__msg__MultiArrayDimension _dimension;
+      /**
+       * Amount of samples in current batch
+      */
+      size_t _count = 0;
+      /**
+       * Time in milliseconds of first sample in current batch
+      */
+      unsigned long _first_sample_ms = 0;
+      /**
+       * Maximum time in milliseconds a sample may wait before the batch is published
+      */
+      const unsigned long _flush_timeout_ms;
+
+    public:
+      /**
+       * Publisher which collects samples into one MultiArray message, and publishes them as a single batch.
+       *
+       * Usage instructions:
+       * - Instantiate before any node is setup.
+       * - Call advertise() in on_setup-method of node or after node setup is completed.
+       * - Call push() for each sample.
+       * - Spin the node as usual.
+       * @param <_ElementType> Element type of samples
+       * @param <BATCH_SIZE> Maximum amount of samples per message
+       * @param node Pointer to node owning the publisher
+       * @param topic_name Topic name (slash and namespace of node is appended later)
+       * @param flush_timeout_ms Maximum time in milliseconds a sample may wait before a partial batch is published
+      */
+      BatchingPublisher(
+        Node* node,
+        const char* topic_name,
+        unsigned long flush_timeout_ms
+      ) noexcept;
+
+      /**
+       * Initializes the publisher, and then advertises the topic onto the ROS2 network.
+       * Node must be successfully initialized for this to succeed.
+       * @return true if success
+      */
+      bool advertise(void) noexcept;
+
+      /**
+       * Adds a sample to the current batch, and publishes the batch if it is full.
+       * If publishing fails, the batch is dropped so that sampling can continue.
+       * @param sample Sample
+       * @return false if a full batch failed to publish
+      */
+      bool push(ElementType sample) noexcept;
+      /**
+       * Adds several samples, publishing each batch that becomes full along the way.
+       * @param samples Pointer to samples
+       * @param count Amount of samples
+       * @return false if any full batch failed to publish
+      */
+      bool push(const ElementType* samples, size_t count) noexcept;
+
+      /**
+       * Publishes the current batch, if it holds any samples.
+       * Publisher must be successfully advertised for this to succeed.
+       * @return true if success or if there was nothing to publish
+      */
+      bool flush(void) noexcept;
+      /**
+       * Publishes the current batch if its oldest sample has waited for the flush timeout.
+       * Called on every spin already, see @see{SpinHook}.
+       * @return true if success or if there was nothing to publish
+      */
+      bool flush_if_due(void) noexcept;
+
+      /**
+       * Retrieves the amount of samples in the current batch
+       * @return Amount of samples
+      */
+      size_t get_count(void) const noexcept;
+    protected:
+      /**
+       * Publishes the current batch if it is due
+      */
+      void on_spin(void) noexcept override;
+      /**
+       * Returns the time until the flush timeout of the current batch expires
+      */
+      uint64_t get_time_until_due_ns(void) const noexcept override;
+  };
+}
+
+#include "batching_publisher_impl.hpp"
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "batching_publisher.hpp"
+
+namespace rclc_cppb
+{
+  template<typename _ElementType, size_t BATCH_SIZE>
+  BatchingPublisher<_ElementType, BATCH_SIZE>::BatchingPublisher(
+    Node* node,
+    const char* topic_name,
+    unsigned long flush_timeout_ms
+  ) noexcept:
+    _publisher(node, topic_name, MessageType()),
+    _message(),
+    _dimension(),
+    _flush_timeout_ms(flush_timeout_ms)
+  {
+    MultiArray<ElementType>::set_memory(this->_message, this->_samples, BATCH_SIZE);
+
+    this->_dimension.label.data = (char*)DIMENSION_LABEL;
+    this->_dimension.label.size = strlen(DIMENSION_LABEL);
+    this->_dimension.label.capacity = this->_dimension.label.size + 1;
+
+    std_msgs__msg__MultiArrayLayout& layout = MultiArray<ElementType>::get_layout(this->_message);
+    layout.dim.data = &this->_dimension;
+    layout.dim.size = 1;
+    layout.dim.capacity = 1;
+    layout.data_offset = 0;
+  }
+
+  template<typename _ElementType, size_t BATCH_SIZE>
+  bool BatchingPublisher<_ElementType, BATCH_SIZE>::advertise(void) noexcept
+  {
+    return this->_publisher.advertise();
+  }
+
+  template<typename _ElementType, size_t BATCH_SIZE>
+  bool BatchingPublisher<_ElementType, BATCH_SIZE>::push(ElementType sample) noexcept
+  {
+    if(this->_count == 0)
+    {
+      this->_first_sample_ms = millis();
+    }
+    this->_samples[this->_count++] = sample;
+
+    if(this->_count < BATCH_SIZE)
+    {
+      return true;
+    }
+    return this->flush();
+  }
+
+  template<typename _ElementType, size_t BATCH_SIZE>
+  bool BatchingPublisher<_ElementType, BATCH_SIZE>::push(const ElementType* samples, size_t count) noexcept
+  {
+    bool success = true;
+    while(count > 0)
+    {
+      if(this->_count == 0)
+      {
+        this->_first_sample_ms = millis();
+      }
+      const size_t room = BATCH_SIZE - this->_count;
+      const size_t chunk = count < room ? count : room;
+      memcpy(&this->_samples[this->_count], samples, chunk*sizeof(ElementType));
+      this->_count += chunk;
+      samples += chunk;
+      count -= chunk;
+
+      if(this->_count == BATCH_SIZE)
+      {
+        success = this->flush() && success;
+      }
+    }
+    return success;
+  }
+
+  template<typename _ElementType, size_t BATCH_SIZE>
+  bool BatchingPublisher<_ElementType, BATCH_SIZE>::flush(void) noexcept
+  {
+    if(this->_count == 0)
+    {
+      return true;
+    }
+    MultiArray<ElementType>::set_size(this->_message, this->_count);
+    this->_dimension.size = this->_count;
+    this->_dimension.stride = this->_count;
+
+    // Batch is dropped on failure, so that a stalled connection does not stall sampling
+    this->_count = 0;
+    return this->_publisher.publish(this->_message);
+  }
+
+  template<typename _ElementType, size_t BATCH_SIZE>
+  bool BatchingPublisher<_ElementType, BATCH_SIZE>::flush_if_due(void) noexcept
+  {
+    if(this->_count == 0 || millis() - this->_first_sample_ms < this->_flush_timeout_ms)
+    {
+      return true;
+    }
+    return this->flush();
+  }
+
+  template<typename _ElementType, size_t BATCH_SIZE>
+  size_t BatchingPublisher<_ElementType, BATCH_SIZE>::get_count(void) const noexcept
+  {
+    return this->_count;
+  }
+
+  template<typename _ElementType, size_t BATCH_SIZE>
+  void BatchingPublisher<_ElementType, BATCH_SIZE>::on_spin(void) noexcept
+  {
+    this->flush_if_due();
+  }
+
+  template<typename _ElementType, size_t BATCH_SIZE>
+  uint64_t BatchingPublisher<_ElementType, BATCH_SIZE>::get_time_until_due_ns(void) const noexcept
+  {
+    if(this->_count == 0)
+    {
+      return SpinHook::NEVER_DUE;
+    }
+    const unsigned long waited_ms = millis() - this->_first_sample_ms;
+    if(waited_ms >= this->_flush_timeout_ms)
+    {
+      return 0;
+    }
+    return RCL_MS_TO_NS((uint64_t)(this->_flush_timeout_ms - waited_ms));
+  }
+}
\ No newline at end of file
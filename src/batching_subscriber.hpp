@@ -0,0 +1,124 @@
+#pragma once
+
+#include <micro_ros_arduino.h>
+#include <rcl/rcl.h>
+#include <rcl/error_handling.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+
+#include "message.hpp"
+#include "multi_array.hpp"
+#include "node.hpp"
+#include "subscriber.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Subscriber receiving batches of samples published by a @see{BatchingPublisher}.
+   *
+   * The message memory is preallocated within the object, so no heap allocation takes place.
+   * Batches larger than the preallocated memory will fail to be received.
+   *
+   * Usage instructions:
+   * - Instantiate before any node is setup.
+   * - Call subscribe() in on_setup-method of node or after node setup is completed.
+   * - Unpack the batch in the callback with @see{unpack}.
+   * - Element type must have MultiArray trait implemented on it.
+   * @param <_ElementType> Element type of samples
+   * @param <BATCH_SIZE> Maximum amount of samples per message
+  */
+  template<typename _ElementType, size_t BATCH_SIZE>
+  class BatchingSubscriber
+  {
+    static_assert(MultiArray<_ElementType>::IS_IMPL, "Trait MultiArray must be implemented!");
+    static_assert(BATCH_SIZE > 0, "Batch size must be at least one sample!");
+
+    public:
+      /**
+       * Element type of samples
+      */
+      using ElementType = _ElementType;
+      /**
+       * MultiArray message type carrying the samples
+      */
+      using MessageType = typename MultiArray<ElementType>::MessageType;
+      /**
+       * Function-pointer type of callback function used by this subscriber
+      */
+      using CallbackType = typename Subscriber<MessageType>::CallbackType;
+
+      /**
+       * Amount of executor handles needed by this subscriber
+      */
+      static constexpr unsigned int HANDLE_COUNT = Subscriber<MessageType>::HANDLE_COUNT;
+
+      /**
+       * Maximum length of the received dimension label, including null-termination
+      */
+      static constexpr size_t DIMENSION_LABEL_CAPACITY = 16;
+    private:
+      /**
+       * Subscriber of the batches
+      */
+      Subscriber<MessageType> _subscriber;
+      /**
+       * Preallocated sample memory
+      */
+      ElementType _samples[BATCH_SIZE];
+      /**
+       * Preallocated layout dimension
+      */
+      std_msgs__msg__MultiArrayDimension _dimension;
+      /**
+       * Preallocated memory for the label of the layout dimension
+      */
+      char _dimension_label[DIMENSION_LABEL_CAPACITY];
+
+    public:
+      /**
+       * Subscriber receiving batches of samples published by a @see{BatchingPublisher}.
+       *
+       * Usage instructions:
+       * - Instantiate before any node is setup.
+       * - Call subscribe() in on_setup-method of node or after node setup is completed.
+       * - Unpack the batch in the callback with @see{unpack}.
+       * @param <_ElementType> Element type of samples
+       * @param <BATCH_SIZE> Maximum amount of samples per message
+       * @param node Pointer to node owning the subscriber
+       * @param topic_name Topic name (slash and namespace of node is appended later)
+       * @param callback Pointer to callback-function used by this subscriber
+      */
+      BatchingSubscriber(Node* node, const char* topic_name, CallbackType callback) noexcept;
+
+      /**
+       * Initializes the subscriber, and then subscribes to the topic on the ROS2 network.
+       * Node must be successfully initialized for this to succeed.
+       * @return true if success
+      */
+      bool subscribe(rclc_executor_handle_invocation_t invocation = ON_NEW_DATA) noexcept;
+
+      /**
+       * Sets the priority class of the subscriber, see @see{Handle::set_priority}
+       * @param priority Priority class
+      */
+      void set_priority(Priority priority) noexcept;
+
+      /**
+       * Retrieves the samples of the last received batch
+       * @param samples Set to point at the first sample
+       * @return Amount of samples
+      */
+      size_t get_last_batch(const ElementType*& samples) noexcept;
+
+      /**
+       * Retrieves the samples of a received batch.
+       * The sample count is taken from the first layout dimension if present.
+       * @param message Received message
+       * @param samples Set to point at the first sample
+       * @return Amount of samples
+      */
+      static size_t unpack(const MessageType* message, const ElementType*& samples) noexcept;
+  };
+}
+
+#include "batching_subscriber_impl.hpp"
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "batching_subscriber.hpp"
+
+namespace rclc_cppb
+{
+  template<typename _ElementType, size_t BATCH_SIZE>
+  BatchingSubscriber<_ElementType, BATCH_SIZE>::BatchingSubscriber(
+    Node* node,
+    const char* topic_name,
+    CallbackType callback
+  ) noexcept:
+    _subscriber(node, topic_name, callback),
+    _dimension()
+  {
+    MessageType message = MessageType();
+    MultiArray<ElementType>::set_memory(message, this->_samples, BATCH_SIZE);
+
+    this->_dimension.label.data = this->_dimension_label;
+    this->_dimension.label.size = 0;
+    this->_dimension.label.capacity = DIMENSION_LABEL_CAPACITY;
+
+    std_msgs__msg__MultiArrayLayout& layout = MultiArray<ElementType>::get_layout(message);
+    layout.dim.data = &this->_dimension;
+    layout.dim.size = 0;
+    layout.dim.capacity = 1;
+
+    this->_subscriber.set_data(message);
+  }
+
+  template<typename _ElementType, size_t BATCH_SIZE>
+  bool BatchingSubscriber<_ElementType, BATCH_SIZE>::subscribe(
+    rclc_executor_handle_invocation_t invocation
+  ) noexcept
+  {
+    return this->_subscriber.subscribe(invocation);
+  }
+
+  template<typename _ElementType, size_t BATCH_SIZE>
+  void BatchingSubscriber<_ElementType, BATCH_SIZE>::set_priority(Priority priority) noexcept
+  {
+    this->_subscriber.set_priority(priority);
+  }
+
+  template<typename _ElementType, size_t BATCH_SIZE>
+  size_t BatchingSubscriber<_ElementType, BATCH_SIZE>::get_last_batch(const ElementType*& samples) noexcept
+  {
+    return BatchingSubscriber::unpack(&this->_subscriber.get_last_data(), samples);
+  }
+
+  template<typename _ElementType, size_t BATCH_SIZE>
+  size_t BatchingSubscriber<_ElementType, BATCH_SIZE>::unpack(
+    const MessageType* message,
+    const ElementType*& samples
+  ) noexcept
+  {
+    const std_msgs__msg__MultiArrayLayout& layout = MultiArray<ElementType>::get_layout(*message);
+    size_t count = MultiArray<ElementType>::get_size(*message);
+    const size_t offset = layout.data_offset < count ? layout.data_offset : count;
+
+    samples = MultiArray<ElementType>::get_elements(*message) + offset;
+    count -= offset;
+    if(layout.dim.size > 0 && layout.dim.data[0].size < count)
+    {
+      count = layout.dim.data[0].size;
+    }
+    return count;
+  }
+}
\ No newline at end of file
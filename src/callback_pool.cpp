@@ -0,0 +1,150 @@
+#include "callback_pool.hpp"
+
+#ifdef RCLC_CPPB_THREADS
+
+namespace rclc_cppb
+{
+  /**
+   * Retrieves the amount of workers to start
+   * @param worker_count Requested amount of workers, zero for one per hardware thread
+   * @return Amount of workers
+  */
+  static size_t get_start_count(size_t worker_count) noexcept
+  {
+    if(worker_count == 0)
+    {
+      worker_count = std::thread::hardware_concurrency();
+    }
+    if(worker_count == 0)
+    {
+      worker_count = 1;
+    }
+    return worker_count < CallbackPool::MAX_WORKER_COUNT ? worker_count : CallbackPool::MAX_WORKER_COUNT;
+  }
+
+  CallbackPool::CallbackPool(size_t worker_count) noexcept:
+    _worker_count(get_start_count(worker_count)),
+    _is_running(true),
+    _next_worker(0),
+    _pending_count(0),
+    _rejected_count(0)
+  {
+    for(size_t i = 0; i < this->_worker_count; i++)
+    {
+      this->_workers[i].thread = std::thread(&CallbackPool::run_worker, this, i);
+    }
+  }
+
+  CallbackPool::~CallbackPool() noexcept
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->_idle_mutex);
+      this->_is_running = false;
+    }
+    this->_idle_condition.notify_all();
+    for(size_t i = 0; i < this->_worker_count; i++)
+    {
+      this->_workers[i].thread.join();
+    }
+  }
+
+  bool CallbackPool::submit(TaskFunction function, void* context) noexcept
+  {
+    {
+      // Counted before queueing, so that the count never drops below zero,
+      // and under the idle mutex, so that a worker about to sleep cannot miss the wake
+      std::lock_guard<std::mutex> lock(this->_idle_mutex);
+      this->_pending_count++;
+    }
+    const size_t first = this->_next_worker.fetch_add(1, std::memory_order_relaxed);
+    for(size_t i = 0; i < this->_worker_count; i++)
+    {
+      Worker& worker = this->_workers[(first + i) % this->_worker_count];
+      {
+        threading::Lock lock(worker.mutex);
+        if(worker.count == CallbackPool::QUEUE_CAPACITY)
+        {
+          continue;
+        }
+        worker.tasks[(worker.head + worker.count) % CallbackPool::QUEUE_CAPACITY] = {function, context};
+        worker.count++;
+      }
+      this->_idle_condition.notify_one();
+      return true;
+    }
+    this->_pending_count--;
+    this->_rejected_count++;
+    return false;
+  }
+
+  size_t CallbackPool::get_worker_count(void) const noexcept
+  {
+    return this->_worker_count;
+  }
+  size_t CallbackPool::get_pending_count(void) const noexcept
+  {
+    return this->_pending_count;
+  }
+  uint32_t CallbackPool::get_rejected_count(void) const noexcept
+  {
+    return this->_rejected_count;
+  }
+
+  void CallbackPool::run_worker(size_t index) noexcept
+  {
+    Worker& own = this->_workers[index];
+    while(true)
+    {
+      Task task;
+      bool has_task = CallbackPool::take_newest(own, task);
+      for(size_t i = 1; !has_task && i < this->_worker_count; i++)
+      {
+        has_task = CallbackPool::take_oldest(this->_workers[(index + i) % this->_worker_count], task);
+      }
+
+      if(has_task)
+      {
+        this->_pending_count--;
+        task.function(task.context);
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(this->_idle_mutex);
+      if(!this->_is_running && this->_pending_count == 0)
+      {
+        return;
+      }
+      this->_idle_condition.wait(lock, [this](void)
+      {
+        return this->_pending_count > 0 || !this->_is_running;
+      });
+    }
+  }
+
+  bool CallbackPool::take_newest(Worker& worker, Task& task) noexcept
+  {
+    threading::Lock lock(worker.mutex);
+    if(worker.count == 0)
+    {
+      return false;
+    }
+    worker.count--;
+    task = worker.tasks[(worker.head + worker.count) % CallbackPool::QUEUE_CAPACITY];
+    return true;
+  }
+
+  bool CallbackPool::take_oldest(Worker& worker, Task& task) noexcept
+  {
+    threading::Lock lock(worker.mutex);
+    if(worker.count == 0)
+    {
+      return false;
+    }
+    task = worker.tasks[worker.head];
+    worker.head = (worker.head + 1) % CallbackPool::QUEUE_CAPACITY;
+    worker.count--;
+    return true;
+  }
+}
+
+#endif
\ No newline at end of file
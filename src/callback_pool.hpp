@@ -0,0 +1,175 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "threading.hpp"
+
+#ifdef RCLC_CPPB_THREADS
+
+#include <condition_variable>
+
+namespace rclc_cppb
+{
+  /**
+   * Pool of worker threads running callbacks off the executor, only available on host builds.
+   *
+   * Every worker has its own fixed-capacity queue. Tasks are spread over the queues round-robin,
+   * a worker runs the newest task of its own queue first, and steals the oldest task of another queue when idle,
+   * so that one slow callback does not hold up the tasks queued behind it.
+   * When all queues are full, submitting fails, which lets the caller apply backpressure.
+   *
+   * Usage instructions:
+   * - Instantiate once, globally or in setup, and share it between @see{PooledSubscriber}s.
+   * - Callbacks run concurrently on the workers, so they must guard whatever they share.
+  */
+  class CallbackPool
+  {
+    public:
+      /**
+       * Function-pointer type of a task
+      */
+      using TaskFunction = void(*)(void* context);
+
+      /**
+       * Maximum amount of tasks queued per worker
+      */
+      static constexpr size_t QUEUE_CAPACITY = 64;
+      /**
+       * Maximum amount of workers
+      */
+      static constexpr size_t MAX_WORKER_COUNT = 32;
+    private:
+      /**
+       * Task queued for a worker
+      */
+      struct Task
+      {
+        /**
+         * Function to run
+        */
+        TaskFunction function;
+        /**
+         * Context passed to function
+        */
+        void* context;
+      };
+      /**
+       * Worker thread with its own queue of tasks
+      */
+      struct Worker
+      {
+        /**
+         * Guards the queue against the owner and thieves
+        */
+        threading::Mutex mutex;
+        /**
+         * Ring buffer of tasks
+        */
+        Task tasks[QUEUE_CAPACITY];
+        /**
+         * Position of oldest task
+        */
+        size_t head = 0;
+        /**
+         * Amount of queued tasks
+        */
+        size_t count = 0;
+        /**
+         * Thread running the tasks
+        */
+        std::thread thread;
+      };
+
+      /**
+       * Workers
+      */
+      Worker _workers[MAX_WORKER_COUNT];
+      /**
+       * Amount of workers running
+      */
+      const size_t _worker_count;
+      /**
+       * true while the workers should keep running
+      */
+      std::atomic<bool> _is_running;
+      /**
+       * Worker the next task is queued for first
+      */
+      std::atomic<size_t> _next_worker;
+      /**
+       * Amount of tasks queued over all workers
+      */
+      std::atomic<size_t> _pending_count;
+      /**
+       * Amount of tasks rejected because all queues were full
+      */
+      std::atomic<uint32_t> _rejected_count;
+      /**
+       * Guards sleeping of idle workers
+      */
+      std::mutex _idle_mutex;
+      /**
+       * Wakes idle workers when a task is queued
+      */
+      std::condition_variable _idle_condition;
+
+    public:
+      /**
+       * Pool of worker threads running callbacks off the executor.
+       * Starts the workers immediately.
+       * @param worker_count Amount of workers, one per hardware thread by default
+      */
+      CallbackPool(size_t worker_count = 0) noexcept;
+      /**
+       * Stops the workers, after they have run all queued tasks
+      */
+      ~CallbackPool() noexcept;
+
+      /**
+       * Queues a task to be run on a worker.
+       * @param function Function to run
+       * @param context Context passed to function
+       * @return false if all queues were full and the task was rejected
+      */
+      bool submit(TaskFunction function, void* context) noexcept;
+
+      /**
+       * Retrieves the amount of workers
+       * @return Amount of workers
+      */
+      size_t get_worker_count(void) const noexcept;
+      /**
+       * Retrieves the amount of tasks queued but not yet started
+       * @return Amount of tasks
+      */
+      size_t get_pending_count(void) const noexcept;
+      /**
+       * Retrieves the amount of tasks rejected because all queues were full
+       * @return Amount of tasks
+      */
+      uint32_t get_rejected_count(void) const noexcept;
+    private:
+      /**
+       * Runs tasks until the pool is stopped and no tasks are left
+       * @param index Index of worker
+      */
+      void run_worker(size_t index) noexcept;
+      /**
+       * Takes the newest task of a worker's own queue
+       * @param worker Worker
+       * @param task Set to the task taken
+       * @return false if the queue was empty
+      */
+      static bool take_newest(Worker& worker, Task& task) noexcept;
+      /**
+       * Takes the oldest task of another worker's queue
+       * @param worker Worker to steal from
+       * @param task Set to the task taken
+       * @return false if the queue was empty
+      */
+      static bool take_oldest(Worker& worker, Task& task) noexcept;
+  };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "clock.hpp"
+
+#include <Arduino.h>
+
+#include "error.hpp"
+#include "threading.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Largest drift accepted in parts per billion, beyond which a measurement is taken to be a jump of the agent clock
+  */
+  static constexpr int64_t MAX_DRIFT_PPB = 1000000;
+
+  bool _is_clock_synced = false;
+  bool _is_auto_stamping = false;
+  int64_t _clock_offset_ns = 0;
+  int64_t _clock_drift_ppb = 0;
+  int64_t _last_sync_local_ns = 0;
+  unsigned long _last_local_us = 0;
+  uint64_t _local_wrap_count = 0;
+  threading::Mutex _clock_mutex;
+
+  Clock::Clock(uint64_t sync_period_ns, int sync_timeout_ms) noexcept:
+    _sync_period_ns(sync_period_ns),
+    _sync_timeout_ms(sync_timeout_ms)
+  {
+    
+  }
+
+  bool Clock::sync(void) noexcept
+  {
+    this->_last_attempt_us = micros();
+    this->_has_attempted = true;
+    return Clock::sync(this->_sync_timeout_ms);
+  }
+
+  bool Clock::sync(int timeout_ms) noexcept
+  {
+    if(
+      !rclc_cppb::error::handled_call<
+        decltype(&rmw_uros_sync_session),
+        &rmw_uros_sync_session
+      >(
+        timeout_ms
+      )
+    )
+    {
+      return false;
+    }
+    const int64_t epoch_ns = rmw_uros_epoch_nanos();
+    const int64_t local_ns = Clock::get_local_ns();
+
+    threading::Lock lock(rclc_cppb::_clock_mutex);
+    if(rclc_cppb::_is_clock_synced)
+    {
+      // The error of the previous prediction, spread over the time since, is what the drift estimate missed
+      const int64_t elapsed_ns = local_ns - rclc_cppb::_last_sync_local_ns;
+      const int64_t elapsed_ms = elapsed_ns/1000000;
+      if(elapsed_ms > 0)
+      {
+        const int64_t predicted_ns = local_ns + rclc_cppb::_clock_offset_ns +
+          elapsed_ns/1000*rclc_cppb::_clock_drift_ppb/1000000;
+        const int64_t error_ppb = (epoch_ns - predicted_ns)*1000/elapsed_ms;
+        if(error_ppb > -MAX_DRIFT_PPB && error_ppb < MAX_DRIFT_PPB)
+        {
+          // Halved, to smooth out the jitter of the round trip
+          rclc_cppb::_clock_drift_ppb += error_ppb/2;
+        }
+      }
+    }
+    rclc_cppb::_clock_offset_ns = epoch_ns - local_ns;
+    rclc_cppb::_last_sync_local_ns = local_ns;
+    rclc_cppb::_is_clock_synced = true;
+    return true;
+  }
+
+  bool Clock::is_synced(void) noexcept
+  {
+    threading::Lock lock(rclc_cppb::_clock_mutex);
+    return rclc_cppb::_is_clock_synced;
+  }
+
+  int64_t Clock::now_ns(void) noexcept
+  {
+    const int64_t local_ns = Clock::get_local_ns();
+    threading::Lock lock(rclc_cppb::_clock_mutex);
+    if(!rclc_cppb::_is_clock_synced)
+    {
+      return 0;
+    }
+    const int64_t elapsed_ns = local_ns - rclc_cppb::_last_sync_local_ns;
+    return local_ns + rclc_cppb::_clock_offset_ns + elapsed_ns/1000*rclc_cppb::_clock_drift_ppb/1000000;
+  }
+
+  int64_t Clock::get_drift_ppb(void) noexcept
+  {
+    threading::Lock lock(rclc_cppb::_clock_mutex);
+    return rclc_cppb::_clock_drift_ppb;
+  }
+
+  void Clock::set_auto_stamp(bool is_auto_stamping) noexcept
+  {
+    rclc_cppb::_is_auto_stamping = is_auto_stamping;
+  }
+  bool Clock::is_auto_stamping(void) noexcept
+  {
+    return rclc_cppb::_is_auto_stamping;
+  }
+
+  void Clock::on_spin(void) noexcept
+  {
+    // Sampled on every spin, so that a wrap of the counter is noticed even if the time is not read
+    (void)Clock::get_local_ns();
+    if(this->get_time_until_due_ns() > 0)
+    {
+      return;
+    }
+    this->sync();
+  }
+
+  uint64_t Clock::get_time_until_due_ns(void) const noexcept
+  {
+    if(!this->_has_attempted)
+    {
+      return 0;
+    }
+    const uint64_t elapsed_ns = RCL_US_TO_NS((uint64_t)(micros() - this->_last_attempt_us));
+    return elapsed_ns < this->_sync_period_ns ? this->_sync_period_ns - elapsed_ns : 0;
+  }
+
+  int64_t Clock::get_local_ns(void) noexcept
+  {
+    threading::Lock lock(rclc_cppb::_clock_mutex);
+    const unsigned long local_us = micros();
+    if constexpr(sizeof(unsigned long) < sizeof(uint64_t))
+    {
+      // Read on every spin by the clock, so no more than one wrap goes by unnoticed as long as the node spins
+      if(local_us < rclc_cppb::_last_local_us)
+      {
+        rclc_cppb::_local_wrap_count++;
+      }
+      rclc_cppb::_last_local_us = local_us;
+      return (int64_t)(((rclc_cppb::_local_wrap_count << (8*sizeof(unsigned long))) + local_us)*1000);
+    }
+    else
+    {
+      return (int64_t)local_us*1000;
+    }
+  }
+}
\ No newline at end of file
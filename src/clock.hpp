@@ -0,0 +1,126 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <micro_ros_arduino.h>
+#include <rmw_microros/rmw_microros.h>
+#include <rcl/rcl.h>
+
+#include "spin_hook.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Epoch clock synchronized with the agent, and kept synchronized by spinning.
+   *
+   * Reading the time with @see{now_ns} never touches the network: it reads the local microsecond counter,
+   * adds the offset measured by the last synchronization, and corrects for the drift of the local oscillator
+   * measured between synchronizations. Only synchronizing blocks, for at most the synchronization timeout,
+   * and it runs on a spin once the synchronization period has elapsed.
+   *
+   * While the clock is synchronized, publishers of message types carrying a std_msgs/Header
+   * stamp it on publish if auto-stamping is enabled, see @see{set_auto_stamp}.
+   *
+   * Usage instructions:
+   * - Instantiate one clock.
+   * - Call sync() in on_setup-method of node or after node setup is completed, or wait for the first spin to do it.
+   * - Spin the node as usual, which synchronizes again whenever the period has elapsed.
+   * - Spin at least once per wrap of the local microsecond counter, about 71 minutes with a 32-bit counter,
+   *   as every spin samples it to notice the wrap.
+  */
+  class Clock: SpinHook
+  {
+    public:
+      /**
+       * Default synchronization period in nanoseconds
+      */
+      static constexpr uint64_t DEFAULT_SYNC_PERIOD_NS = RCL_MS_TO_NS(10000);
+      /**
+       * Default synchronization timeout in milliseconds
+      */
+      static constexpr int DEFAULT_SYNC_TIMEOUT_MS = 10;
+    private:
+      /**
+       * Synchronization period in nanoseconds
+      */
+      const uint64_t _sync_period_ns;
+      /**
+       * Synchronization timeout in milliseconds
+      */
+      const int _sync_timeout_ms;
+      /**
+       * Time of the last synchronization attempt, in microseconds
+      */
+      unsigned long _last_attempt_us = 0;
+      /**
+       * true once a synchronization has been attempted
+      */
+      bool _has_attempted = false;
+
+    public:
+      /**
+       * Epoch clock synchronized with the agent, and kept synchronized by spinning.
+       * @param sync_period_ns Synchronization period in nanoseconds
+       * @param sync_timeout_ms Synchronization timeout in milliseconds
+      */
+      explicit Clock(
+        uint64_t sync_period_ns = Clock::DEFAULT_SYNC_PERIOD_NS,
+        int sync_timeout_ms = Clock::DEFAULT_SYNC_TIMEOUT_MS
+      ) noexcept;
+      Clock(const Clock&) = delete;
+
+      /**
+       * Synchronizes with the agent right away, blocking until it answers or the timeout expires
+       * @return true if success
+      */
+      bool sync(void) noexcept;
+
+      /**
+       * Synchronizes with the agent, blocking until it answers or the timeout expires,
+       * then updates the offset and drift of the clock.
+       * @param timeout_ms Timeout in milliseconds
+       * @return true if success
+      */
+      static bool sync(int timeout_ms) noexcept;
+      /**
+       * Returns true if the clock has been synchronized with the agent
+      */
+      static bool is_synced(void) noexcept;
+      /**
+       * Retrieves the synchronized epoch time without touching the network
+       * @return Time in nanoseconds since the epoch, or zero if not synchronized
+      */
+      static int64_t now_ns(void) noexcept;
+      /**
+       * Retrieves the measured drift of the local oscillator against the agent
+       * @return Drift in parts per billion, positive if the local oscillator runs slow
+      */
+      static int64_t get_drift_ppb(void) noexcept;
+      /**
+       * Sets whether publishers of message types carrying a std_msgs/Header stamp it on publish
+       * while the clock is synchronized. Disabled by default.
+       * @param is_auto_stamping true to stamp messages
+      */
+      static void set_auto_stamp(bool is_auto_stamping) noexcept;
+      /**
+       * Returns true if publishers stamp headers on publish, see @see{set_auto_stamp}
+      */
+      static bool is_auto_stamping(void) noexcept;
+    protected:
+      /**
+       * Samples the local microsecond counter, then synchronizes once the period has elapsed
+      */
+      void on_spin(void) noexcept override;
+      /**
+       * Returns the time until the period has elapsed
+      */
+      uint64_t get_time_until_due_ns(void) const noexcept override;
+    private:
+      /**
+       * Reads the local microsecond counter, widened to 64 bits so that it does not wrap.
+       * A wrap is only noticed if the counter is read again within one wrap, which every spin does.
+       * @return Local time in nanoseconds
+      */
+      static int64_t get_local_ns(void) noexcept;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "coroutine.hpp"
+
+#ifdef RCLC_CPPB_COROUTINES
+
+#include <Arduino.h>
+
+namespace rclc_cppb
+{
+  namespace coroutine
+  {
+    static_assert(RCLC_CPPB_COROUTINE_FRAME_COUNT > 0 && RCLC_CPPB_COROUTINE_FRAME_COUNT <= 32, "Frame count must be between 1 and 32!");
+
+    static constexpr size_t FRAME_SIZE = (RCLC_CPPB_COROUTINE_FRAME_SIZE + alignof(max_align_t) - 1)/alignof(max_align_t)*alignof(max_align_t);
+
+    alignas(max_align_t) static uint8_t _frames[RCLC_CPPB_COROUTINE_FRAME_COUNT][FRAME_SIZE];
+    /**
+     * One bit per frame, set while taken
+    */
+    static uint32_t _taken_frames = 0;
+
+    void* allocate_frame(size_t size) noexcept
+    {
+      if(size > FRAME_SIZE)
+      {
+        return NULL;
+      }
+      for(size_t i = 0; i < RCLC_CPPB_COROUTINE_FRAME_COUNT; i++)
+      {
+        if((_taken_frames & ((uint32_t)1 << i)) == 0)
+        {
+          _taken_frames |= (uint32_t)1 << i;
+          return _frames[i];
+        }
+      }
+      return NULL;
+    }
+
+    void deallocate_frame(void* frame) noexcept
+    {
+      const size_t index = (size_t)((uint8_t*)frame - &_frames[0][0])/FRAME_SIZE;
+      _taken_frames &= ~((uint32_t)1 << index);
+    }
+
+    size_t get_free_frame_count(void) noexcept
+    {
+      size_t count = 0;
+      for(size_t i = 0; i < RCLC_CPPB_COROUTINE_FRAME_COUNT; i++)
+      {
+        if((_taken_frames & ((uint32_t)1 << i)) == 0)
+        {
+          count++;
+        }
+      }
+      return count;
+    }
+  }
+
+  Task Task::promise_type::get_return_object(void) noexcept
+  {
+    return Task(true);
+  }
+  Task Task::promise_type::get_return_object_on_allocation_failure(void) noexcept
+  {
+    return Task(false);
+  }
+  std::suspend_never Task::promise_type::initial_suspend(void) const noexcept
+  {
+    return std::suspend_never();
+  }
+  std::suspend_never Task::promise_type::final_suspend(void) const noexcept
+  {
+    return std::suspend_never();
+  }
+  void Task::promise_type::return_void(void) const noexcept {}
+  void Task::promise_type::unhandled_exception(void) const noexcept {}
+
+  void* Task::promise_type::operator new(size_t size) noexcept
+  {
+    return rclc_cppb::coroutine::allocate_frame(size);
+  }
+  void Task::promise_type::operator delete(void* frame) noexcept
+  {
+    rclc_cppb::coroutine::deallocate_frame(frame);
+  }
+
+  Task::Task(bool is_started) noexcept:
+    _is_started(is_started)
+  {
+
+  }
+
+  bool Task::is_started(void) const noexcept
+  {
+    return this->_is_started;
+  }
+
+  SleepAwaitable::SleepAwaitable(uint64_t duration_ns) noexcept:
+    _duration_ns(duration_ns),
+    _start_us(micros())
+  {
+
+  }
+
+  bool SleepAwaitable::await_ready(void) const noexcept
+  {
+    return this->get_remaining_ns() == 0;
+  }
+  void SleepAwaitable::await_suspend(std::coroutine_handle<> handle) noexcept
+  {
+    this->_handle = handle;
+  }
+  void SleepAwaitable::await_resume(void) const noexcept {}
+
+  void SleepAwaitable::on_spin(void) noexcept
+  {
+    if(!this->_handle || this->get_remaining_ns() > 0)
+    {
+      return;
+    }
+    // Resuming destroys this awaitable, so nothing may be accessed after
+    const std::coroutine_handle<> handle = this->_handle;
+    this->_handle = std::coroutine_handle<>();
+    handle.resume();
+  }
+  uint64_t SleepAwaitable::get_time_until_due_ns(void) const noexcept
+  {
+    if(!this->_handle)
+    {
+      return SpinHook::NEVER_DUE;
+    }
+    return this->get_remaining_ns();
+  }
+
+  uint64_t SleepAwaitable::get_remaining_ns(void) const noexcept
+  {
+    const uint64_t elapsed_ns = RCL_US_TO_NS((uint64_t)(micros() - this->_start_us));
+    return elapsed_ns < this->_duration_ns ? this->_duration_ns - elapsed_ns : 0;
+  }
+
+  SleepAwaitable sleep_for(uint64_t duration_ns) noexcept
+  {
+    return SleepAwaitable(duration_ns);
+  }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "spin_hook.hpp"
+
+/**
+ * Coroutine support, which is only available when compiling as C++20 or later.
+ * Then RCLC_CPPB_COROUTINES is defined.
+*/
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+  #define RCLC_CPPB_COROUTINES
+#endif
+
+/**
+ * Size in bytes of each coroutine frame in the frame pool.
+ * Coroutines whose frame is larger fail to start.
+*/
+#ifndef RCLC_CPPB_COROUTINE_FRAME_SIZE
+  #define RCLC_CPPB_COROUTINE_FRAME_SIZE 512
+#endif
+/**
+ * Amount of coroutine frames in the frame pool, which is the maximum amount of coroutines running at once
+*/
+#ifndef RCLC_CPPB_COROUTINE_FRAME_COUNT
+  #define RCLC_CPPB_COROUTINE_FRAME_COUNT 4
+#endif
+
+#ifdef RCLC_CPPB_COROUTINES
+
+#include <coroutine>
+
+namespace rclc_cppb
+{
+  namespace coroutine
+  {
+    /**
+     * Takes a frame from the frame pool
+     * @param size Size of frame in bytes
+     * @return Pointer to frame, or NULL if too large or none is free
+    */
+    void* allocate_frame(size_t size) noexcept;
+    /**
+     * Returns a frame to the frame pool
+     * @param frame Pointer to frame
+    */
+    void deallocate_frame(void* frame) noexcept;
+    /**
+     * Retrieves the amount of free frames in the frame pool
+     * @return Amount of frames
+    */
+    size_t get_free_frame_count(void) noexcept;
+  }
+
+  /**
+   * Coroutine started by calling it, which runs until its first co_await and is then resumed from within
+   * @see{Node::spin_once} whenever what it awaits is ready. Its frame is freed when it returns.
+   *
+   * Frames are taken from a fixed-size pool instead of the heap, see RCLC_CPPB_COROUTINE_FRAME_SIZE and
+   * RCLC_CPPB_COROUTINE_FRAME_COUNT. A coroutine fails to start if its frame is too large or none is free.
+   *
+   * Usage instructions:
+   * - Declare a function returning Task, and co_await e.g. @see{Subscriber::next},
+   *   @see{ServiceClient::async_call} or @see{sleep_for} within.
+   * - Call it once the entities it uses are set up, and check @see{is_started}.
+   * - Keep spinning the node, which resumes the coroutine.
+  */
+  class Task
+  {
+    public:
+      /**
+       * Promise of the coroutine, used by the compiler
+      */
+      struct promise_type
+      {
+        /**
+         * Returns a started task
+        */
+        Task get_return_object(void) noexcept;
+        /**
+         * Returns a task which failed to start, when no frame could be taken from the pool
+        */
+        static Task get_return_object_on_allocation_failure(void) noexcept;
+        /**
+         * Runs the coroutine right away, until its first co_await
+        */
+        std::suspend_never initial_suspend(void) const noexcept;
+        /**
+         * Frees the frame as soon as the coroutine returns
+        */
+        std::suspend_never final_suspend(void) const noexcept;
+        void return_void(void) const noexcept;
+        void unhandled_exception(void) const noexcept;
+
+        /**
+         * Takes the frame from the frame pool
+         * @param size Size of frame in bytes
+        */
+        static void* operator new(size_t size) noexcept;
+        /**
+         * Returns the frame to the frame pool
+         * @param frame Pointer to frame
+        */
+        static void operator delete(void* frame) noexcept;
+      };
+    private:
+      /**
+       * true if a frame was available and the coroutine started
+      */
+      bool _is_started;
+
+      /**
+       * Coroutine started by calling it
+       * @param is_started true if a frame was available and the coroutine started
+      */
+      explicit Task(bool is_started) noexcept;
+
+    public:
+      /**
+       * Returns true if a frame was available and the coroutine started
+      */
+      bool is_started(void) const noexcept;
+  };
+
+  /**
+   * Awaitable resuming its coroutine once a number of received messages changes,
+   * with a pointer to the received message, or NULL on timeout or failure.
+   * Returned by @see{Subscriber::next} and @see{ServiceClient::async_call}.
+   * @param <_ResultType> Message type pointed to once resumed
+  */
+  template<typename _ResultType>
+  class ReceiveAwaitable: SpinHook
+  {
+    public:
+      /**
+       * Timeout which never expires
+      */
+      static constexpr uint64_t NO_TIMEOUT = UINT64_MAX;
+    private:
+      /**
+       * Pointer to number of received messages, or NULL if failed
+      */
+      const uint32_t* const _receive_count;
+      /**
+       * Number of received messages to wait past
+      */
+      const uint32_t _start_count;
+      /**
+       * Pointer to sequence number of the last received message, or NULL if any message will do
+      */
+      const int64_t* const _sequence_number;
+      /**
+       * Sequence number of the message to wait for
+      */
+      const int64_t _expected_sequence_number;
+      /**
+       * Pointer to flag cleared once this awaitable is destroyed, or NULL
+      */
+      bool* const _in_use;
+      /**
+       * Pointer to the received message
+      */
+      const _ResultType* const _result;
+      /**
+       * Timeout in nanoseconds
+      */
+      const uint64_t _timeout_ns;
+      /**
+       * Time when awaiting started, in microseconds
+      */
+      const unsigned long _start_us;
+      /**
+       * Suspended coroutine, or empty while not suspended
+      */
+      std::coroutine_handle<> _handle;
+
+    public:
+      /**
+       * Awaitable resuming its coroutine once a number of received messages changes
+       * @param receive_count Pointer to number of received messages, or NULL to resume at once with NULL
+       * @param start_count Number of received messages to wait past, read before whatever triggers the message
+       * @param result Pointer to the received message
+       * @param timeout_ns Timeout in nanoseconds
+       * @param sequence_number Pointer to sequence number of the last received message, or NULL if any message will do
+       * @param expected_sequence_number Sequence number of the message to wait for, e.g. of a service request
+       * @param in_use Pointer to flag cleared once this awaitable is destroyed, or NULL
+      */
+      ReceiveAwaitable(
+        const uint32_t* receive_count,
+        uint32_t start_count,
+        const _ResultType* result,
+        uint64_t timeout_ns,
+        const int64_t* sequence_number = NULL,
+        int64_t expected_sequence_number = 0,
+        bool* in_use = NULL
+      ) noexcept;
+      ReceiveAwaitable(const ReceiveAwaitable&) = delete;
+      ~ReceiveAwaitable() noexcept;
+
+      /**
+       * Returns true if awaiting is not needed, as it failed already
+      */
+      bool await_ready(void) const noexcept;
+      /**
+       * Keeps the coroutine to resume once a message is received or the timeout expires
+       * @param handle Suspended coroutine
+      */
+      void await_suspend(std::coroutine_handle<> handle) noexcept;
+      /**
+       * @return Pointer to the received message, valid until the next spin, or NULL on timeout or failure
+      */
+      const _ResultType* await_resume(void) const noexcept;
+    protected:
+      /**
+       * Resumes the coroutine once a message is received or the timeout expires
+      */
+      void on_spin(void) noexcept override;
+      /**
+       * Returns zero once a message is received, otherwise the time until the timeout expires
+      */
+      uint64_t get_time_until_due_ns(void) const noexcept override;
+    private:
+      /**
+       * Returns true if a message was received since awaiting started, with the expected sequence number if any
+      */
+      bool is_received(void) const noexcept;
+      /**
+       * Returns true if the timeout has expired
+      */
+      bool is_timed_out(void) const noexcept;
+  };
+
+  /**
+   * Awaitable resuming its coroutine once a duration has elapsed, returned by @see{sleep_for}
+  */
+  class SleepAwaitable: SpinHook
+  {
+    private:
+      /**
+       * Duration in nanoseconds
+      */
+      const uint64_t _duration_ns;
+      /**
+       * Time when sleeping started, in microseconds
+      */
+      const unsigned long _start_us;
+      /**
+       * Suspended coroutine, or empty while not suspended
+      */
+      std::coroutine_handle<> _handle;
+
+    public:
+      /**
+       * Awaitable resuming its coroutine once a duration has elapsed
+       * @param duration_ns Duration in nanoseconds
+      */
+      explicit SleepAwaitable(uint64_t duration_ns) noexcept;
+      SleepAwaitable(const SleepAwaitable&) = delete;
+      ~SleepAwaitable() noexcept = default;
+
+      /**
+       * Returns true if the duration has elapsed already
+      */
+      bool await_ready(void) const noexcept;
+      /**
+       * Keeps the coroutine to resume once the duration has elapsed
+       * @param handle Suspended coroutine
+      */
+      void await_suspend(std::coroutine_handle<> handle) noexcept;
+      void await_resume(void) const noexcept;
+    protected:
+      /**
+       * Resumes the coroutine once the duration has elapsed
+      */
+      void on_spin(void) noexcept override;
+      /**
+       * Returns the time until the duration has elapsed
+      */
+      uint64_t get_time_until_due_ns(void) const noexcept override;
+    private:
+      /**
+       * Retrieves the remaining duration
+       * @return Duration in nanoseconds, zero if elapsed
+      */
+      uint64_t get_remaining_ns(void) const noexcept;
+  };
+
+  /**
+   * Suspends a coroutine for a duration, while the node keeps spinning.
+   * The wake-up time bounds adaptive spins, see @see{Node::get_adaptive_timeout_ns}.
+   * @param duration_ns Duration in nanoseconds
+   * @return Awaitable
+  */
+  SleepAwaitable sleep_for(uint64_t duration_ns) noexcept;
+}
+
+#include "coroutine_impl.hpp"
+
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "coroutine.hpp"
+
+namespace rclc_cppb
+{
+  template<typename _ResultType>
+  ReceiveAwaitable<_ResultType>::ReceiveAwaitable(
+    const uint32_t* receive_count,
+    uint32_t start_count,
+    const _ResultType* result,
+    uint64_t timeout_ns,
+    const int64_t* sequence_number,
+    int64_t expected_sequence_number,
+    bool* in_use
+  ) noexcept:
+    _receive_count(receive_count),
+    _start_count(start_count),
+    _sequence_number(sequence_number),
+    _expected_sequence_number(expected_sequence_number),
+    _in_use(in_use),
+    _result(result),
+    _timeout_ns(timeout_ns),
+    _start_us(micros())
+  {
+
+  }
+  template<typename _ResultType>
+  ReceiveAwaitable<_ResultType>::~ReceiveAwaitable() noexcept
+  {
+    if(this->_in_use != NULL)
+    {
+      *this->_in_use = false;
+    }
+  }
+
+  template<typename _ResultType>
+  bool ReceiveAwaitable<_ResultType>::await_ready(void) const noexcept
+  {
+    return this->_receive_count == NULL;
+  }
+  template<typename _ResultType>
+  void ReceiveAwaitable<_ResultType>::await_suspend(std::coroutine_handle<> handle) noexcept
+  {
+    this->_handle = handle;
+  }
+  template<typename _ResultType>
+  const _ResultType* ReceiveAwaitable<_ResultType>::await_resume(void) const noexcept
+  {
+    return this->is_received() ? this->_result : NULL;
+  }
+
+  template<typename _ResultType>
+  void ReceiveAwaitable<_ResultType>::on_spin(void) noexcept
+  {
+    if(!this->_handle || (!this->is_received() && !this->is_timed_out()))
+    {
+      return;
+    }
+    // Resuming destroys this awaitable, so nothing may be accessed after
+    const std::coroutine_handle<> handle = this->_handle;
+    this->_handle = std::coroutine_handle<>();
+    handle.resume();
+  }
+  template<typename _ResultType>
+  uint64_t ReceiveAwaitable<_ResultType>::get_time_until_due_ns(void) const noexcept
+  {
+    if(!this->_handle)
+    {
+      return SpinHook::NEVER_DUE;
+    }
+    if(this->is_received())
+    {
+      return 0;
+    }
+    if(this->_timeout_ns == ReceiveAwaitable::NO_TIMEOUT)
+    {
+      return SpinHook::NEVER_DUE;
+    }
+    const uint64_t elapsed_ns = RCL_US_TO_NS((uint64_t)(micros() - this->_start_us));
+    return elapsed_ns < this->_timeout_ns ? this->_timeout_ns - elapsed_ns : 0;
+  }
+
+  template<typename _ResultType>
+  bool ReceiveAwaitable<_ResultType>::is_received(void) const noexcept
+  {
+    return this->_receive_count != NULL && *this->_receive_count != this->_start_count &&
+      (this->_sequence_number == NULL || *this->_sequence_number == this->_expected_sequence_number);
+  }
+  template<typename _ResultType>
+  bool ReceiveAwaitable<_ResultType>::is_timed_out(void) const noexcept
+  {
+    return this->_timeout_ns != ReceiveAwaitable::NO_TIMEOUT &&
+      RCL_US_TO_NS((uint64_t)(micros() - this->_start_us)) >= this->_timeout_ns;
+  }
+}
\ No newline at end of file
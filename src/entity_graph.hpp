@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <rcl/rcl.h>
+#include <rclc/executor.h>
+
+#include "node.hpp"
+#include "static_arena.hpp"
+
+/**
+ * Bytes reserved in the executor arena for the wait set implementation of rcl, on top of its per-handle arrays.
+ * Matches rcl_wait_set_impl_t of rcl/src/rcl/wait.c: six indices, five rmw arrays of a count and a pointer,
+ * the rmw wait set and context pointers, and the allocator.
+ * The rmw wait set itself comes from the static memory of rmw_microxrcedds, not from this allocator.
+*/
+#ifndef RCLC_CPPB_WAIT_SET_OVERHEAD
+  #define RCLC_CPPB_WAIT_SET_OVERHEAD (11*sizeof(size_t) + 7*sizeof(void*) + sizeof(rcl_allocator_t))
+#endif
+
+namespace rclc_cppb
+{
+  /**
+   * Compile-time list of the entities of a program, e.g. its publishers, subscribers, service servers and clients.
+   *
+   * Derives the exact amount of executor handles, the size of the entities including their preallocated messages,
+   * and the size of the executor storage, all as constants which can be checked with static_assert.
+   * Every entity type must declare its HANDLE_COUNT.
+   *
+   * Usage instructions:
+   * - Declare the graph from the types of the global entities, e.g. @code{EntityGraph<decltype(publisher), decltype(subscriber)>}.
+   * - Check the memory budget with @code{static_assert(Graph::fits(BUDGET))}.
+   * - Instantiate a global @code{Graph::ExecutorArena}, and pass it to @see{use} before any node is setup.
+   * @param <_EntityTypes> Entity types
+  */
+  template<typename... _EntityTypes>
+  struct EntityGraph
+  {
+    /**
+     * Exact amount of executor handles needed by the entities
+    */
+    static constexpr unsigned int HANDLE_COUNT = (0u + ... + _EntityTypes::HANDLE_COUNT);
+    /**
+     * Total size of the entities in bytes, which includes their message storage
+    */
+    static constexpr size_t ENTITY_SIZE = ((size_t)0 + ... + sizeof(_EntityTypes));
+    /**
+     * Size of the executor storage in bytes: its handles, and the wait set rcl builds from them.
+     * Allocated are the handle array of the executor, the wait set implementation,
+     * and an rcl and an rmw array per entity type, each holding one pointer per handle.
+    */
+    static constexpr size_t EXECUTOR_SIZE = static_arena::get_required_size(
+      1 + 1 + 2*6,
+      HANDLE_COUNT*(sizeof(rclc_executor_handle_t) + 2*sizeof(void*)) + RCLC_CPPB_WAIT_SET_OVERHEAD
+    );
+    /**
+     * Total static memory needed in bytes
+    */
+    static constexpr size_t TOTAL_SIZE = ENTITY_SIZE + EXECUTOR_SIZE;
+
+    /**
+     * Static memory the executor is allocated from
+    */
+    using ExecutorArena = StaticArena<EXECUTOR_SIZE>;
+
+    /**
+     * Returns true if the entities and the executor fit in a memory budget
+     * @param budget Memory budget in bytes
+    */
+    static constexpr bool fits(size_t budget) noexcept
+    {
+      return TOTAL_SIZE <= budget;
+    }
+
+    /**
+     * Makes the executor allocate from static memory, sized for exactly the handles of the graph.
+     * Adding a handle the graph does not list fails like on a full executor.
+     * Call before any node is setup.
+     * @param arena Static memory the executor is allocated from
+     * @param <ARENA_SIZE> Size of arena in bytes, which must hold the executor storage
+    */
+    template<size_t ARENA_SIZE>
+    static void use(StaticArena<ARENA_SIZE>& arena) noexcept
+    {
+      static_assert(ARENA_SIZE >= EXECUTOR_SIZE, "Arena is too small for the executor handles of the graph!");
+      Node::use_static_executor(arena.get_allocator(), HANDLE_COUNT);
+    }
+  };
+}
\ No newline at end of file
@@ -0,0 +1,260 @@
+#include "error.hpp"
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace rclc_cppb::error
+{
+  CallSite* CallSite::_first = NULL;
+
+  Failure _recent_failures[RCLC_CPPB_ERROR_HISTORY_SIZE];
+  size_t _next_failure_index = 0;
+  size_t _recent_failure_count = 0;
+  uint32_t _failure_count = 0;
+  threading::Mutex _failure_mutex;
+
+  #ifdef RCLC_CPPB_COMPACT_ERRORS
+    CallSite _call_sites[RCLC_CPPB_ERROR_SITE_COUNT];
+  #endif
+
+  /**
+   * Finds the counter index of a return code
+   * @param return_code Return code
+   * @return Index into the counters of a call site, the last one for codes not counted separately
+  */
+  static size_t get_code_index(rcl_ret_t return_code) noexcept
+  {
+    for(size_t i = 0; i < COUNTED_RETURN_CODE_COUNT; i++)
+    {
+      if(COUNTED_RETURN_CODES[i] == return_code)
+      {
+        return i;
+      }
+    }
+    return COUNTED_RETURN_CODE_COUNT;
+  }
+
+  size_t CallSite::get_name(char* buffer, size_t size) const noexcept
+  {
+    #ifdef RCLC_CPPB_COMPACT_ERRORS
+      // Only the address is known, e.g. "0x0801a2c4", to be resolved with addr2line
+      const int length = snprintf(buffer, size, "0x%lx", (unsigned long)this->_function);
+      return length > 0 ? (size_t)length : 0;
+    #else
+      size_t length;
+      const char* name = get_function_name(this->_signature, &length);
+      if(size > 0)
+      {
+        const size_t copy_length = length < size ? length : size - 1;
+        memcpy(buffer, name, copy_length);
+        buffer[copy_length] = '\0';
+      }
+      return length;
+    #endif
+  }
+  uint32_t CallSite::get_count(rcl_ret_t return_code) const noexcept
+  {
+    threading::Lock lock(_failure_mutex);
+    return this->_counts[get_code_index(return_code)];
+  }
+  uint32_t CallSite::get_total_count(void) const noexcept
+  {
+    threading::Lock lock(_failure_mutex);
+    uint32_t total = 0;
+    for(uint32_t count: this->_counts)
+    {
+      total += count;
+    }
+    return total;
+  }
+  unsigned long CallSite::get_last_failure_us(void) const noexcept
+  {
+    return this->_last_failure_us;
+  }
+  rcl_ret_t CallSite::get_last_return_code(void) const noexcept
+  {
+    return this->_last_return_code;
+  }
+
+  const CallSite* CallSite::get_first(void) noexcept
+  {
+    return CallSite::_first;
+  }
+  const CallSite* CallSite::get_next(void) const noexcept
+  {
+    return this->_next;
+  }
+
+  const char* get_function_name(const char* signature, size_t* length) noexcept
+  {
+    if(signature == NULL)
+    {
+      *length = 0;
+      return "";
+    }
+    // GCC gives "[with Fn = ...; Fn FUNCTION = rcl_publish]", clang "[Fn = ..., FUNCTION = &rcl_publish]"
+    const char* name = strstr(signature, "FUNCTION = ");
+    if(name == NULL)
+    {
+      *length = strlen(signature);
+      return signature;
+    }
+    name += strlen("FUNCTION = ");
+    if(*name == '&')
+    {
+      name++;
+    }
+    *length = strcspn(name, ";,]");
+    return name;
+  }
+
+  void CallSite::count(rcl_ret_t return_code, unsigned long now_us) noexcept
+  {
+    this->_counts[get_code_index(return_code)]++;
+    this->_last_failure_us = now_us;
+    this->_last_return_code = return_code;
+  }
+
+  /**
+   * Adds a failure to the recent failures, the lock being held
+   * @param site Call site of the failed function, or NULL
+   * @param return_code Return code of the failure
+   * @param now_us Time of the failure in microseconds
+  */
+  static void add_recent_failure(const CallSite* site, rcl_ret_t return_code, unsigned long now_us) noexcept
+  {
+    _failure_count++;
+    if(_recent_failure_count > 0)
+    {
+      // Failures in a row are merged, so that e.g. timing out spins do not push out everything else
+      Failure& latest = _recent_failures[
+        (_next_failure_index + RCLC_CPPB_ERROR_HISTORY_SIZE - 1) % RCLC_CPPB_ERROR_HISTORY_SIZE
+      ];
+      if(latest.site == site && latest.return_code == return_code)
+      {
+        latest.time_us = now_us;
+        latest.repeat_count++;
+        return;
+      }
+    }
+    _recent_failures[_next_failure_index] = {site, return_code, now_us, 1};
+    _next_failure_index = (_next_failure_index + 1) % RCLC_CPPB_ERROR_HISTORY_SIZE;
+    if(_recent_failure_count < RCLC_CPPB_ERROR_HISTORY_SIZE)
+    {
+      _recent_failure_count++;
+    }
+  }
+
+  void record_failure(CallSite* site, const char* signature, rcl_ret_t return_code) noexcept
+  {
+    const unsigned long now_us = micros();
+    threading::Lock lock(_failure_mutex);
+    if(site->_signature == NULL)
+    {
+      site->_signature = signature;
+      site->_next = CallSite::_first;
+      CallSite::_first = site;
+    }
+    site->count(return_code, now_us);
+    add_recent_failure(site, return_code, now_us);
+  }
+
+  #ifdef RCLC_CPPB_COMPACT_ERRORS
+    void record_failure(uintptr_t function, rcl_ret_t return_code) noexcept
+    {
+      const unsigned long now_us = micros();
+      threading::Lock lock(_failure_mutex);
+      CallSite* site = NULL;
+      for(CallSite& candidate: _call_sites)
+      {
+        if(candidate._function == function)
+        {
+          site = &candidate;
+          break;
+        }
+        if(candidate._function == 0)
+        {
+          candidate._function = function;
+          candidate._next = CallSite::_first;
+          CallSite::_first = &candidate;
+          site = &candidate;
+          break;
+        }
+      }
+      // Still counted in total once the table is full
+      if(site != NULL)
+      {
+        site->count(return_code, now_us);
+      }
+      add_recent_failure(site, return_code, now_us);
+    }
+
+    FailureHook _failure_hook = NULL;
+
+    void set_failure_hook(FailureHook hook) noexcept
+    {
+      _failure_hook = hook;
+    }
+
+    bool handle_shared(rcl_ret_t return_code, uintptr_t function) noexcept
+    {
+      // Same cases as handle() in error_impl.hpp
+      bool is_fatal;
+      switch(return_code)
+      {
+        case RCL_RET_OK:
+        case RCL_RET_ALREADY_INIT:
+          return true;
+        case RCL_RET_ERROR:
+        case RCL_RET_TIMEOUT:
+          is_fatal = false;
+          break;
+        default:
+          is_fatal = true;
+          break;
+      }
+      // The function is only known by its address, so its call site is looked up at the first failure
+      record_failure(function, return_code);
+      RCLC_CPPB_TRACE(ERROR, "handled_call", return_code);
+      if(_failure_hook != NULL)
+      {
+        _failure_hook(function, return_code, is_fatal);
+      }
+      return false;
+    }
+  #endif
+
+  uint32_t get_failure_count(void) noexcept
+  {
+    threading::Lock lock(_failure_mutex);
+    return _failure_count;
+  }
+
+  bool get_recent_failure(size_t index, Failure* failure) noexcept
+  {
+    threading::Lock lock(_failure_mutex);
+    if(index >= _recent_failure_count)
+    {
+      return false;
+    }
+    *failure = _recent_failures[
+      (_next_failure_index + RCLC_CPPB_ERROR_HISTORY_SIZE - 1 - index) % RCLC_CPPB_ERROR_HISTORY_SIZE
+    ];
+    return true;
+  }
+
+  void reset_failures(void) noexcept
+  {
+    threading::Lock lock(_failure_mutex);
+    for(CallSite* site = CallSite::_first; site != NULL; site = site->_next)
+    {
+      memset(site->_counts, 0, sizeof(site->_counts));
+      site->_last_failure_us = 0;
+      site->_last_return_code = RCL_RET_OK;
+    }
+    _next_failure_index = 0;
+    _recent_failure_count = 0;
+    _failure_count = 0;
+  }
+}
\ No newline at end of file
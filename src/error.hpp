@@ -6,8 +6,238 @@
 #include <rclc/rclc.h>
 #include <rclc/executor.h>
 
+#include "trace.hpp"
+
+#include "threading.hpp"
+
+/**
+ * Amount of recent failures kept by @see{error::get_recent_failure}
+*/
+#ifndef RCLC_CPPB_ERROR_HISTORY_SIZE
+  #define RCLC_CPPB_ERROR_HISTORY_SIZE 8
+#endif
+
+/**
+ * Flash-size reduction of the error handling.
+ *
+ * By default, every rcl function called through @see{error::handled_call} gets its own handler,
+ * with its own switch, failure actions and name. If RCLC_CPPB_COMPACT_ERRORS is defined for the whole build,
+ * all of them share one non-template handler, and only the check for success is inlined at each call.
+ * Call sites are then kept in a table of RCLC_CPPB_ERROR_SITE_COUNT entries, and named by the address
+ * of the function instead, which addr2line resolves.
+ * The shared handler is compiled within the library, so it ignores the ERROR_ONCE and ERROR_LOOP macros;
+ * register the failure action with @see{error::set_failure_hook} instead.
+ * See extras/size_report.py for the code size per template instantiation.
+*/
+#ifndef RCLC_CPPB_ERROR_SITE_COUNT
+  #define RCLC_CPPB_ERROR_SITE_COUNT 16
+#endif
+
 namespace rclc_cppb::error
 {
+  /**
+   * Return codes counted separately by call sites, see @see{CallSite::get_count}
+  */
+  static constexpr rcl_ret_t COUNTED_RETURN_CODES[] = {
+    RCL_RET_ERROR,
+    RCL_RET_TIMEOUT,
+    RCL_RET_BAD_ALLOC,
+    RCL_RET_INVALID_ARGUMENT,
+    RCL_RET_PUBLISHER_INVALID,
+    RCL_RET_SUBSCRIPTION_INVALID,
+    RCL_RET_CLIENT_INVALID,
+    RCL_RET_SERVICE_INVALID,
+    RCL_RET_NODE_INVALID
+  };
+  /**
+   * Amount of return codes counted separately, besides the one count of all other codes
+  */
+  static constexpr size_t COUNTED_RETURN_CODE_COUNT = sizeof(COUNTED_RETURN_CODES)/sizeof(rcl_ret_t);
+
+  /**
+   * Failure counters of one rcl function called through @see{handled_call}.
+   *
+   * There is one per function, kept in an intrusive list from its first failure on,
+   * so functions which never fail take up no time and only a few bytes.
+  */
+  class CallSite
+  {
+    private:
+      /**
+       * First call site in the list
+      */
+      static CallSite* _first;
+      /**
+       * Next call site in the list
+      */
+      CallSite* _next = NULL;
+      /**
+       * Signature of the error handler, whose template arguments name the function
+      */
+      const char* _signature = NULL;
+      #ifdef RCLC_CPPB_COMPACT_ERRORS
+        /**
+         * Address of the function, 0 while the entry of the table is unused
+        */
+        uintptr_t _function = 0;
+      #endif
+      /**
+       * Failures per counted return code, and of all other codes last
+      */
+      uint32_t _counts[COUNTED_RETURN_CODE_COUNT + 1] = {};
+      /**
+       * Time in microseconds of the last failure
+      */
+      unsigned long _last_failure_us = 0;
+      /**
+       * Return code of the last failure
+      */
+      rcl_ret_t _last_return_code = RCL_RET_OK;
+
+    public:
+      constexpr CallSite(void) noexcept = default;
+      CallSite(const CallSite&) = delete;
+
+      /**
+       * Copies the name of the function into given buffer, truncated to fit
+       * @param buffer Buffer the null-terminated name is written to
+       * @param size Size of buffer
+       * @return Length of the whole name
+      */
+      size_t get_name(char* buffer, size_t size) const noexcept;
+      /**
+       * Retrieves the amount of failures with given return code
+       * @param return_code Return code, one of @see{COUNTED_RETURN_CODES}, any other giving the count of all others
+       * @return Amount of failures
+      */
+      uint32_t get_count(rcl_ret_t return_code) const noexcept;
+      /**
+       * Retrieves the amount of failures with any return code
+      */
+      uint32_t get_total_count(void) const noexcept;
+      /**
+       * Retrieves the time of the last failure
+       * @return Time in microseconds, see micros()
+      */
+      unsigned long get_last_failure_us(void) const noexcept;
+      /**
+       * Retrieves the return code of the last failure
+      */
+      rcl_ret_t get_last_return_code(void) const noexcept;
+
+      /**
+       * Retrieves the first call site which has failed
+       * @return Pointer to call site, or NULL if nothing has failed
+      */
+      static const CallSite* get_first(void) noexcept;
+      /**
+       * Retrieves the next call site which has failed
+       * @return Pointer to call site, or NULL if last
+      */
+      const CallSite* get_next(void) const noexcept;
+
+    private:
+      /**
+       * Counts a failure, the lock being held
+       * @param return_code Return code of the failure
+       * @param now_us Time of the failure in microseconds
+      */
+      void count(rcl_ret_t return_code, unsigned long now_us) noexcept;
+
+      friend void record_failure(CallSite* site, const char* signature, rcl_ret_t return_code) noexcept;
+      #ifdef RCLC_CPPB_COMPACT_ERRORS
+        friend void record_failure(uintptr_t function, rcl_ret_t return_code) noexcept;
+      #endif
+      friend void reset_failures(void) noexcept;
+  };
+
+  /**
+   * Recent failure, see @see{get_recent_failure}
+  */
+  struct Failure
+  {
+    /**
+     * Call site of the failed function, NULL if the table of call sites was full, see RCLC_CPPB_COMPACT_ERRORS
+    */
+    const CallSite* site;
+    /**
+     * Return code of the failure
+    */
+    rcl_ret_t return_code;
+    /**
+     * Time in microseconds of the latest failure, see micros()
+    */
+    unsigned long time_us;
+    /**
+     * Amount of failures in a row with the same function and return code, merged into this one
+    */
+    uint32_t repeat_count;
+  };
+
+  /**
+   * Finds the name of the function in the signature of its error handler
+   * @param signature Signature of the error handler, as given by @see{record_failure}
+   * @param length Pointer to where the length of the name is written
+   * @return Start of the name, which is not null-terminated
+  */
+  const char* get_function_name(const char* signature, size_t* length) noexcept;
+  /**
+   * Counts a failure of a function, and adds it to the recent failures. Called by @see{handle}.
+   * @param site Call site of the function
+   * @param signature Signature of the error handler, naming the function
+   * @param return_code Return code of the failure
+  */
+  void record_failure(CallSite* site, const char* signature, rcl_ret_t return_code) noexcept;
+  #ifdef RCLC_CPPB_COMPACT_ERRORS
+    /**
+     * Counts a failure of a function, and adds it to the recent failures. Called by @see{handle_shared}.
+     * @param function Address of the function
+     * @param return_code Return code of the failure
+    */
+    void record_failure(uintptr_t function, rcl_ret_t return_code) noexcept;
+
+    /**
+     * Function-pointer type of the failure action, taking the place of the ERROR_ONCE and ERROR_LOOP macros
+     * when RCLC_CPPB_COMPACT_ERRORS is defined, as the shared handler is compiled within the library
+     * @param function Address of the failed function
+     * @param return_code Return code of the failure
+     * @param is_fatal true for failures handled by ERROR_LOOP otherwise, false for those handled by ERROR_ONCE
+    */
+    using FailureHook = void(*)(
+      uintptr_t function,
+      rcl_ret_t return_code,
+      bool is_fatal
+    );
+    /**
+     * Sets the failure action called by @see{handle_shared} after a failure is recorded.
+     * Set it before any node is setup.
+     * @param hook Pointer to failure action, or NULL to just return false upon failure
+    */
+    void set_failure_hook(FailureHook hook) noexcept;
+    /**
+     * Error handling shared by all rclc functions, see RCLC_CPPB_COMPACT_ERRORS. Called by @see{handle} upon failure.
+     * @param return_code rclc return code received from function-call
+     * @param function Address of the function
+     * @return true if success
+    */
+    bool handle_shared(rcl_ret_t return_code, uintptr_t function) noexcept;
+  #endif
+  /**
+   * Retrieves the amount of failures of all functions
+  */
+  uint32_t get_failure_count(void) noexcept;
+  /**
+   * Retrieves a recent failure
+   * @param index Index of the failure, 0 being the latest
+   * @param failure Pointer to where the failure is written
+   * @return true if there is a failure at given index
+  */
+  bool get_recent_failure(size_t index, Failure* failure) noexcept;
+  /**
+   * Resets the counters of all call sites, and forgets the recent failures
+  */
+  void reset_failures(void) noexcept;
+
   /**
    * Error handling for rclc functions.
    * 
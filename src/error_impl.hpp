@@ -62,26 +62,46 @@ namespace rclc_cppb::error
       }
   #endif
   
-  template<typename Fn, Fn FUNCTION>
-  bool handle(rcl_ret_t return_code) noexcept
-  {
-    switch(return_code)
+  #ifdef RCLC_CPPB_COMPACT_ERRORS
+    template<typename Fn, Fn FUNCTION>
+    inline bool handle(rcl_ret_t return_code) noexcept
     {
-      CASE_OK(RCL_RET_OK, )
-      CASE_OK(RCL_RET_ALREADY_INIT, )
-      CASE_ERROR_ONCE(RCL_RET_ERROR, )
-      CASE_ERROR_ONCE(RCL_RET_TIMEOUT, )
-      CASE_ERROR_LOOP(RCL_RET_INVALID_ARGUMENT, )
-      CASE_ERROR_LOOP(RCL_RET_PUBLISHER_INVALID, )
-      CASE_ERROR_LOOP(RCL_RET_CLIENT_INVALID, )
-      CASE_ERROR_LOOP(RCL_RET_SERVICE_INVALID, )
-      CASE_ERROR_LOOP(RCL_RET_SUBSCRIPTION_INVALID, )
-      CASE_ERROR_LOOP(RCL_RET_NODE_INVALID, )
-      CASE_ERROR_LOOP(RCL_RET_BAD_ALLOC, )
-      // Add more if needed
-      DEFAULT_ERROR_LOOP()
+      // Success is checked inline, so that only failures take the shared path
+      return return_code == RCL_RET_OK || handle_shared(return_code, (uintptr_t)FUNCTION);
     }
-  }
+  #else
+    // The signature of the handler names the failed function through its template arguments
+    #define RECORD_FAILURE \
+      record_failure(&site, __PRETTY_FUNCTION__, return_code);
+    #define ON_FAILURE \
+      RECORD_FAILURE \
+      RCLC_CPPB_TRACE(ERROR, __PRETTY_FUNCTION__, return_code);
+
+    // One handler per function, the switch below being its body. The cases are mirrored by handle_shared in error.cpp.
+    template<typename Fn, Fn FUNCTION>
+    bool handle(rcl_ret_t return_code) noexcept
+    {
+      // One per function, constant-initialized, so that no guard is needed
+      static CallSite site;
+      switch(return_code)
+      {
+        CASE_OK(RCL_RET_OK, )
+        CASE_OK(RCL_RET_ALREADY_INIT, )
+        CASE_ERROR_ONCE(RCL_RET_ERROR, ON_FAILURE)
+        // Spins time out whenever nothing arrives, so they leave out timeouts before handling, see Node::spin_once
+        CASE_ERROR_ONCE(RCL_RET_TIMEOUT, ON_FAILURE)
+        CASE_ERROR_LOOP(RCL_RET_INVALID_ARGUMENT, ON_FAILURE)
+        CASE_ERROR_LOOP(RCL_RET_PUBLISHER_INVALID, ON_FAILURE)
+        CASE_ERROR_LOOP(RCL_RET_CLIENT_INVALID, ON_FAILURE)
+        CASE_ERROR_LOOP(RCL_RET_SERVICE_INVALID, ON_FAILURE)
+        CASE_ERROR_LOOP(RCL_RET_SUBSCRIPTION_INVALID, ON_FAILURE)
+        CASE_ERROR_LOOP(RCL_RET_NODE_INVALID, ON_FAILURE)
+        CASE_ERROR_LOOP(RCL_RET_BAD_ALLOC, ON_FAILURE)
+        // Add more if needed
+        DEFAULT_ERROR_LOOP(ON_FAILURE)
+      }
+    }
+  #endif
 
   // The following specializations will not compile. Instead using default above.
   /*#define HANDLE_IMPL(FUNCTION, RETURN_CODE_VARIABLE_NAME) \
@@ -284,6 +304,8 @@ namespace rclc_cppb::error
 }
 
 #undef HANDLE_IMPL
+#undef ON_FAILURE
+#undef RECORD_FAILURE
 #undef CASE_OK
 #undef CASE_ERROR_ONCE
 #undef CASE_ERROR_LOOP
@@ -0,0 +1,157 @@
+#include "guard_condition.hpp"
+
+#include "error.hpp"
+
+// https://micro.ros.org/docs/tutorials/programming_rcl_rclc/executor/
+
+namespace rclc_cppb
+{
+  GuardCondition* GuardCondition::_first = NULL;
+  threading::Flag GuardCondition::_is_any_pending(false);
+
+  GuardCondition::GuardCondition(Node* node, CallbackType callback) noexcept:
+    Handle(node, GuardCondition::HANDLE_COUNT),
+    _next(GuardCondition::_first),
+    _guard_condition(rcl_get_zero_initialized_guard_condition()),
+    _callback(callback)
+  {
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    GuardCondition::_first = this;
+  }
+
+  GuardCondition::~GuardCondition() noexcept
+  {
+    this->_init_stage = InitStage::NEW;
+    {
+      threading::RecursiveLock lock(threading::get_spin_mutex());
+      for(GuardCondition** guard_condition = &GuardCondition::_first; *guard_condition != NULL; guard_condition = &(*guard_condition)->_next)
+      {
+        if(*guard_condition == this)
+        {
+          *guard_condition = this->_next;
+          break;
+        }
+      }
+    }
+
+    rclc_cppb::error::handled_call<
+      decltype(&rcl_guard_condition_fini),
+      &rcl_guard_condition_fini
+    >(
+      &this->_guard_condition
+    );
+  }
+
+  bool GuardCondition::attach(void) noexcept
+  {
+    static_assert(InitStage::NEW < InitStage::INIT_DONE);
+    if(this->_init_stage < InitStage::INIT_DONE)
+    {
+      if(
+        !rclc_cppb::error::handled_call<
+          decltype(&rcl_guard_condition_init),
+          &rcl_guard_condition_init
+        >(
+          &this->_guard_condition,
+          Handle::get_context_mut(),
+          rcl_guard_condition_get_default_options()
+        )
+      )
+      {
+        rclc_cppb::error::handled_call<
+          decltype(&rcl_guard_condition_fini),
+          &rcl_guard_condition_fini
+        >(
+          &this->_guard_condition
+        );
+        return false;
+      }
+      this->_init_stage = InitStage::INIT_DONE;
+    }
+    static_assert(InitStage::INIT_DONE < InitStage::EXECUTOR_DONE);
+    if(this->_init_stage < InitStage::EXECUTOR_DONE)
+    {
+      if(
+        !rclc_cppb::error::handled_call<
+          decltype(&rclc_executor_add_guard_condition),
+          &rclc_executor_add_guard_condition
+        >(
+          Handle::get_executor_mut(),
+          &this->_guard_condition,
+          this->_callback
+        )
+      )
+      {
+        return false;
+      }
+      this->_init_stage = InitStage::EXECUTOR_DONE;
+      this->on_executor_added(&this->_guard_condition);
+    }
+    return true;
+  }
+
+  bool GuardCondition::trigger(void) noexcept
+  {
+    if(this->_init_stage < InitStage::EXECUTOR_DONE)
+    {
+      return false;
+    }
+    this->_trigger_us = micros();
+    // rcl is not safe within an interrupt, so the next spin triggers the rcl guard condition
+    this->_is_pending = true;
+    GuardCondition::_is_any_pending = true;
+    Node::notify();
+    return true;
+  }
+
+  void GuardCondition::trigger_pending(void) noexcept
+  {
+    if(!GuardCondition::_is_any_pending)
+    {
+      return;
+    }
+    // Cleared before triggering, so that a trigger arriving meanwhile is kept for the next spin
+    GuardCondition::_is_any_pending = false;
+    for(GuardCondition* guard_condition = GuardCondition::_first; guard_condition != NULL; guard_condition = guard_condition->_next)
+    {
+      if(!guard_condition->_is_pending)
+      {
+        continue;
+      }
+      guard_condition->_is_pending = false;
+      // Dropped if the guard condition was detached since, like a trigger before attach()
+      if(guard_condition->_init_stage < InitStage::EXECUTOR_DONE)
+      {
+        continue;
+      }
+      rclc_cppb::error::handled_call<
+        decltype(&rcl_trigger_guard_condition),
+        &rcl_trigger_guard_condition
+      >(
+        &guard_condition->_guard_condition
+      );
+    }
+  }
+
+  unsigned long GuardCondition::get_latency_us(void) const noexcept
+  {
+    return micros() - this->_trigger_us;
+  }
+
+  bool GuardCondition::on_session_lost(void) noexcept
+  {
+    if(this->_init_stage < InitStage::INIT_DONE)
+    {
+      return false;
+    }
+    this->_init_stage = InitStage::NEW;
+    // Errors are expected, as the context is gone
+    (void)rcl_guard_condition_fini(&this->_guard_condition);
+    this->_guard_condition = rcl_get_zero_initialized_guard_condition();
+    return true;
+  }
+  bool GuardCondition::on_session_restored(void) noexcept
+  {
+    return this->attach();
+  }
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <micro_ros_arduino.h>
+#include <rcl/rcl.h>
+#include <rcl/error_handling.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+
+#include "node.hpp"
+#include "handle.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * ROS2 guard condition, used to wake the executor from an interrupt or another event source.
+   *
+   * Triggering the guard condition makes its callback run on the next spin,
+   * without waiting for a message to arrive or for the loop to come around.
+   * A trigger only sets a flag, the rcl guard condition is triggered by the next spin before the executor waits.
+   *
+   * Usage instructions:
+   * - Instantiate before any node is setup.
+   * - Call attach() in on_setup-method of node or after node setup is completed.
+   * - Call trigger() from an interrupt service routine or anywhere else.
+  */
+  class GuardCondition: Handle
+  {
+    public:
+      /**
+       * Function-pointer type of callback function used by this guard condition
+      */
+      using CallbackType = void(*)(void);
+
+      /**
+       * Amount of executor handles needed by this guard condition
+      */
+      static constexpr unsigned int HANDLE_COUNT = 1;
+    private:
+      /**
+       * First guard condition in the list
+      */
+      static GuardCondition* _first;
+      /**
+       * true if any guard condition has a trigger pending
+      */
+      static threading::Flag _is_any_pending;
+      /**
+       * Next guard condition in the list
+      */
+      GuardCondition* _next;
+      /**
+       * rcl guard condition entity
+      */
+      rcl_guard_condition_t _guard_condition;
+      /**
+       * Callback function used by this guard condition
+      */
+      CallbackType _callback;
+      /**
+       * Stage of initialization for this guard condition
+      */
+      InitStage _init_stage = InitStage::NEW;
+      /**
+       * Time in microseconds of last trigger
+      */
+      volatile unsigned long _trigger_us = 0;
+      /**
+       * true if triggered since the last spin
+      */
+      threading::Flag _is_pending{false};
+
+    public:
+      /**
+       * ROS2 guard condition, used to wake the executor from an interrupt or another event source.
+       *
+       * Usage instructions:
+       * - Instantiate before any node is setup.
+       * - Call attach() in on_setup-method of node or after node setup is completed.
+       * - Call trigger() from an interrupt service routine or anywhere else.
+       * @param node Pointer to node owning the guard condition
+       * @param callback Pointer to callback-function called on the spin following a trigger
+      */
+      GuardCondition(Node* node, CallbackType callback) noexcept;
+
+      ~GuardCondition() noexcept;
+
+      using Handle::set_priority;
+      using Handle::get_priority;
+
+      /**
+       * Initializes the guard condition, and then adds it to the executor.
+       * Node must be successfully initialized for this to succeed.
+       * @return true if success
+      */
+      bool attach(void) noexcept;
+
+      /**
+       * Triggers the guard condition, so that its callback runs on the next spin.
+       * Also wakes @see{Node::spin_when_ready}.
+       * Safe to call from an interrupt service routine, as it only sets flags and leaves the rcl call to the next spin.
+       * Triggers before that spin are merged into one.
+       * Does nothing until the guard condition is attached.
+       * @return true if attached
+      */
+      bool trigger(void) noexcept;
+
+      /**
+       * Retrieves the time passed since the last trigger.
+       * Call from within the callback to measure the trigger-to-callback latency.
+       * @return Time in microseconds
+      */
+      unsigned long get_latency_us(void) const noexcept;
+    protected:
+      /**
+       * Finalizes the guard condition after the session to the agent was lost
+       * @return true if it had been attached
+      */
+      bool on_session_lost(void) noexcept override;
+      /**
+       * Attaches the guard condition again after the session to the agent was restored
+       * @return true if success
+      */
+      bool on_session_restored(void) noexcept override;
+    private:
+      /**
+       * Triggers the rcl guard condition of every guard condition with a trigger pending.
+       * Called by every spin before the executor waits, with the spin mutex held.
+      */
+      static void trigger_pending(void) noexcept;
+
+      friend class Node;
+  };
+}
\ No newline at end of file
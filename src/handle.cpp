@@ -2,16 +2,103 @@
 
 namespace rclc_cppb
 {
+  Handle* Handle::_first = NULL;
+  threading::Counter Handle::_lost_message_count(0);
+
+  /**
+   * Retrieves the rcl entity of an executor handle
+   * @param handle Executor handle
+   * @return Pointer to the rcl entity
+  */
+  static const void* get_entity(const rclc_executor_handle_t& handle) noexcept
+  {
+    switch(handle.type)
+    {
+      case RCLC_SUBSCRIPTION:
+      case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+        return handle.subscription;
+      case RCLC_TIMER:
+        return handle.timer;
+      case RCLC_CLIENT:
+      case RCLC_CLIENT_WITH_REQUEST_ID:
+        return handle.client;
+      case RCLC_SERVICE:
+      case RCLC_SERVICE_WITH_REQUEST_ID:
+      case RCLC_SERVICE_WITH_CONTEXT:
+        return handle.service;
+      case RCLC_GUARD_CONDITION:
+      case RCLC_GUARD_CONDITION_WITH_CONTEXT:
+        return handle.gc;
+      default:
+        return NULL;
+    }
+  }
+
   Handle::Handle(Node* node) noexcept:
-    _node(node)
+    _node(node),
+    _next(Handle::_first)
   {
-    Node::add_handle();
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    Handle::_first = this;
+    node->add_handle();
   }
 
   Handle::Handle(Node* node, unsigned int handle_count) noexcept:
-    _node(node)
+    _node(node),
+    _next(Handle::_first)
+  {
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    Handle::_first = this;
+    node->add_handles(handle_count);
+  }
+
+  Handle::~Handle() noexcept
+  {
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    for(Handle** handle = &Handle::_first; *handle != NULL; handle = &(*handle)->_next)
+    {
+      if(*handle == this)
+      {
+        *handle = this->_next;
+        break;
+      }
+    }
+  }
+
+  void Handle::set_priority(Priority priority) noexcept
+  {
+    this->_priority = priority;
+    if(this->_entity != NULL)
+    {
+      Handle::sort_executor_handles(this->get_executor_mut());
+    }
+  }
+  Priority Handle::get_priority(void) const noexcept
+  {
+    return this->_priority;
+  }
+
+  uint32_t Handle::get_lost_message_count(void) noexcept
+  {
+    return Handle::_lost_message_count;
+  }
+
+  void Handle::on_executor_added(const void* entity) noexcept
+  {
+    this->_entity = entity;
+    Handle::sort_executor_handles(this->get_executor_mut());
+  }
+  bool Handle::on_session_lost(void) noexcept
+  {
+    return false;
+  }
+  bool Handle::on_session_restored(void) noexcept
+  {
+    return true;
+  }
+  void Handle::count_lost_message(void) noexcept
   {
-    Node::add_handles(handle_count);
+    Handle::_lost_message_count++;
   }
 
   const Node* Handle::get_node(void) const noexcept
@@ -31,12 +118,83 @@ namespace rclc_cppb
   {
     return this->get_node_mut()->get_handle_mut();
   }
-  const rclc_executor_t* Handle::get_executor(void) noexcept
+  rclc_executor_t* Handle::get_executor_mut(void) noexcept
   {
-    return Node::get_executor();
+    return this->get_node_mut()->get_node_executor_mut();
   }
-  rclc_executor_t* Handle::get_executor_mut(void) noexcept
+  rcl_context_t* Handle::get_context_mut(void) noexcept
+  {
+    return Node::get_context_mut();
+  }
+
+  void Handle::sort_executor_handles(rclc_executor_t* executor) noexcept
+  {
+    // rclc dispatches in array order and rebuilds its wait set after every addition,
+    // so reordering the array right after adding is safe.
+    // Insertion sort, as it is stable and there are only a few handles.
+    for(size_t i = 1; i < executor->index; i++)
+    {
+      const rclc_executor_handle_t handle = executor->handles[i];
+      const Priority priority = Handle::find_priority(get_entity(handle));
+      size_t j = i;
+      while(j > 0 && Handle::find_priority(get_entity(executor->handles[j - 1])) < priority)
+      {
+        executor->handles[j] = executor->handles[j - 1];
+        j--;
+      }
+      executor->handles[j] = handle;
+    }
+  }
+
+  Priority Handle::find_priority(const void* entity) noexcept
+  {
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    if(entity == NULL)
+    {
+      return Priority::NORMAL;
+    }
+    for(const Handle* handle = Handle::_first; handle != NULL; handle = handle->_next)
+    {
+      if(handle->_entity == entity)
+      {
+        return handle->_priority;
+      }
+    }
+    return Priority::NORMAL;
+  }
+
+  void Handle::lose_all(void) noexcept
+  {
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    for(Handle* handle = Handle::_first; handle != NULL; handle = handle->_next)
+    {
+      handle->_entity = NULL;
+      if(handle->on_session_lost())
+      {
+        handle->_is_lost = true;
+      }
+    }
+  }
+
+  bool Handle::restore_all(void) noexcept
   {
-    return Node::get_executor_mut();
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    bool success = true;
+    for(Handle* handle = Handle::_first; handle != NULL; handle = handle->_next)
+    {
+      if(!handle->_is_lost)
+      {
+        continue;
+      }
+      if(handle->on_session_restored())
+      {
+        handle->_is_lost = false;
+      }
+      else
+      {
+        success = false;
+      }
+    }
+    return success;
   }
 }
\ No newline at end of file
@@ -1,15 +1,29 @@
 #pragma once
 
 #include "node.hpp"
+#include "threading.hpp"
 
 namespace rclc_cppb
 {
+  /**
+   * Priority class of a handle.
+   * The executor dispatches handles of a higher priority before those of a lower priority,
+   * and handles of equal priority in the order they were added.
+  */
+  enum class Priority: uint8_t
+  {
+    LOW = 0,
+    NORMAL = 1,
+    HIGH = 2,
+    CRITICAL = 3
+  };
+
   /**
    * A ROS2 entity which requires handling by the executor
   */
   class Handle
   {
-    private:
+    protected:
       /**
        * State of initialization
       */
@@ -19,11 +33,36 @@ namespace rclc_cppb
         INIT_DONE = 1,
         EXECUTOR_DONE = 2
       };
-      
+
+    private:
       /**
        * A mutable pointer to the node that owns this object
       */
       Node* const _node;
+      /**
+       * First handle in the list of all handles
+      */
+      static Handle* _first;
+      /**
+       * Next handle in the list of all handles
+      */
+      Handle* _next;
+      /**
+       * Priority class of this handle
+      */
+      Priority _priority = Priority::NORMAL;
+      /**
+       * Pointer to the rcl entity added to the executor, or NULL if not added yet
+      */
+      const void* _entity = NULL;
+      /**
+       * true if the rcl entity was lost along with the session, and is to be created again
+      */
+      bool _is_lost = false;
+      /**
+       * Amount of messages lost because they could not be sent
+      */
+      static threading::Counter _lost_message_count;
 
     protected:
       /**
@@ -44,6 +83,55 @@ namespace rclc_cppb
        * @param handle_count Amount of handles to add to handle-counter
       */
       Handle(Node* node, unsigned int handle_count) noexcept;
+      /**
+       * Removes this handle from the list of all handles
+      */
+      ~Handle() noexcept;
+
+    public:
+      /**
+       * Sets the priority class of this handle, which orders its dispatch within the executor.
+       * May be changed at any time, but is best set before the handle is added to the executor.
+       * @param priority Priority class
+      */
+      void set_priority(Priority priority) noexcept;
+      /**
+       * Retrieves the priority class of this handle
+       * @return Priority class
+      */
+      Priority get_priority(void) const noexcept;
+
+      /**
+       * Retrieves the amount of messages lost by all handles because they could not be sent,
+       * e.g. while the session to the agent is lost
+       * @return Amount of messages
+      */
+      static uint32_t get_lost_message_count(void) noexcept;
+
+    protected:
+      /**
+       * To be called when the rcl entity of this handle has been added to the executor.
+       * Moves the entity ahead of those of lower priority.
+       * @param entity Pointer to the rcl entity
+      */
+      void on_executor_added(const void* entity) noexcept;
+      /**
+       * Called when the session to the agent is lost, see @see{ReconnectSupervisor}.
+       * Finalizes the rcl entity without waiting for the agent, and resets the stage of initialization,
+       * so that it can be created again. Does nothing and returns false unless overrided.
+       * @return true if the rcl entity had been created, and is to be created again once the session is restored
+      */
+      virtual bool on_session_lost(void) noexcept;
+      /**
+       * Called once the session to the agent is restored, if the rcl entity had been created before it was lost.
+       * Creates the rcl entity again. Does nothing and returns true unless overrided.
+       * @return true if success
+      */
+      virtual bool on_session_restored(void) noexcept;
+      /**
+       * Counts a message lost because it could not be sent
+      */
+      static void count_lost_message(void) noexcept;
 
       /**
        * Retrieves a pointer to the node that owns this object
@@ -67,14 +155,38 @@ namespace rclc_cppb
       */
       rcl_node_t* get_node_handle_mut(void) noexcept;
       /**
-       * Retrieves a pointer to the rclc executor struct
-       * @return Pointer to the rclc executor struct
+       * Retrieves a mutable pointer to the rclc executor struct this handle is added to,
+       * which is the executor of its node if threaded, otherwise the shared one
+       * @return Mutable pointer to the rclc executor struct
       */
-      static const rclc_executor_t* get_executor(void) noexcept;
+      rclc_executor_t* get_executor_mut(void) noexcept;
       /**
-       * Retrieves a mutable pointer to the rclc executor struct
-       * @return Mutable pointer to the rclc executor struct
+       * Retrieves a mutable pointer to the rcl context entity
+       * @return Mutable pointer to the rcl context entity
       */
-      static rclc_executor_t* get_executor_mut(void) noexcept;
+      static rcl_context_t* get_context_mut(void) noexcept;
+    private:
+      /**
+       * Orders the handles of an executor by priority, keeping the order of handles of equal priority
+       * @param executor Mutable pointer to the rclc executor struct
+      */
+      static void sort_executor_handles(rclc_executor_t* executor) noexcept;
+      /**
+       * Finds the priority class of the handle owning an rcl entity
+       * @param entity Pointer to the rcl entity
+       * @return Priority class, or @code{Priority::NORMAL} if not owned by any handle
+      */
+      static Priority find_priority(const void* entity) noexcept;
+      /**
+       * Finalizes the rcl entities of all handles after the session to the agent was lost
+      */
+      static void lose_all(void) noexcept;
+      /**
+       * Creates the lost rcl entities of all handles again after the session to the agent was restored
+       * @return true if all were created
+      */
+      static bool restore_all(void) noexcept;
+
+      friend class Node;
   };
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "latency_probe.hpp"
+
+namespace rclc_cppb
+{
+  void LatencyHistogram::record(int64_t latency_ns) noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    if(latency_ns < 0)
+    {
+      this->_early_count++;
+      return;
+    }
+    const uint64_t latency_us_wide = (uint64_t)latency_ns/1000;
+    const uint32_t latency_us = latency_us_wide > UINT32_MAX ? UINT32_MAX : (uint32_t)latency_us_wide;
+
+    size_t index = 0;
+    for(uint32_t rest = latency_us >> 1; rest != 0 && index < LatencyHistogram::BUCKET_COUNT - 1; rest >>= 1)
+    {
+      index++;
+    }
+    this->_buckets[index]++;
+
+    if(this->_count == 0 || latency_us < this->_min_us)
+    {
+      this->_min_us = latency_us;
+    }
+    if(latency_us > this->_max_us)
+    {
+      this->_max_us = latency_us;
+    }
+    this->_sum_us += latency_us;
+    this->_count++;
+  }
+
+  void LatencyHistogram::reset(void) noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    for(size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; i++)
+    {
+      this->_buckets[i] = 0;
+    }
+    this->_count = 0;
+    this->_early_count = 0;
+    this->_sum_us = 0;
+    this->_min_us = 0;
+    this->_max_us = 0;
+  }
+
+  uint32_t LatencyHistogram::get_count(void) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    return this->_count;
+  }
+  uint32_t LatencyHistogram::get_early_count(void) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    return this->_early_count;
+  }
+  uint32_t LatencyHistogram::get_bucket_count(size_t index) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    return index < LatencyHistogram::BUCKET_COUNT ? this->_buckets[index] : 0;
+  }
+  uint32_t LatencyHistogram::get_min_us(void) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    return this->_min_us;
+  }
+  uint32_t LatencyHistogram::get_mean_us(void) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    return this->_count > 0 ? (uint32_t)(this->_sum_us/this->_count) : 0;
+  }
+  uint32_t LatencyHistogram::get_max_us(void) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    return this->_max_us;
+  }
+
+  uint32_t LatencyHistogram::get_percentile_us(float percentile) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    if(this->_count == 0)
+    {
+      return 0;
+    }
+    const uint32_t target = (uint32_t)(this->_count*percentile/100.0f);
+    uint32_t seen = 0;
+    for(size_t i = 0; i < LatencyHistogram::BUCKET_COUNT - 1; i++)
+    {
+      seen += this->_buckets[i];
+      if(seen > target)
+      {
+        // Upper bound of the bucket, but never beyond what was recorded
+        const uint32_t bound_us = (2u << i) - 1;
+        return bound_us < this->_max_us ? bound_us : this->_max_us;
+      }
+    }
+    return this->_max_us;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <type_traits>
+
+#include <micro_ros_arduino.h>
+#include <builtin_interfaces/msg/time.h>
+#include <rcl/rcl.h>
+
+#include "clock.hpp"
+#include "threading.hpp"
+
+namespace rclc_cppb
+{
+  namespace latency
+  {
+    /**
+     * true if type carries a std_msgs/Header, i.e. has member header with member stamp
+    */
+    template<typename _Type, typename = void>
+    struct HasHeader: std::false_type {};
+    template<typename _Type>
+    struct HasHeader<
+      _Type,
+      std::void_t<
+        decltype(std::declval<_Type>().header.stamp.sec),
+        decltype(std::declval<_Type>().header.stamp.nanosec)
+      >
+    >: std::true_type {};
+    /**
+     * true if type is a std_msgs/Header itself, i.e. has member stamp
+    */
+    template<typename _Type, typename = void>
+    struct IsHeader: std::false_type {};
+    template<typename _Type>
+    struct IsHeader<
+      _Type,
+      std::void_t<
+        decltype(std::declval<_Type>().stamp.sec),
+        decltype(std::declval<_Type>().stamp.nanosec),
+        decltype(std::declval<_Type>().frame_id)
+      >
+    >: std::true_type {};
+    /**
+     * true if messages of a type carry a timestamp which can be probed
+    */
+    template<typename _Type>
+    struct IsStamped: std::integral_constant<bool, HasHeader<_Type>::value || IsHeader<_Type>::value> {};
+
+    /**
+     * Retrieves the header timestamp of a message
+     * @param message Message, whose type must carry a timestamp, see @see{IsStamped}
+     * @return Reference to timestamp
+    */
+    template<typename _MessageType>
+    builtin_interfaces__msg__Time& get_stamp(_MessageType& message) noexcept;
+    /**
+     * Retrieves the header timestamp of a message as nanoseconds since the epoch
+     * @param message Message, whose type must carry a timestamp, see @see{IsStamped}
+     * @return Time in nanoseconds
+    */
+    template<typename _MessageType>
+    int64_t get_stamp_ns(const _MessageType& message) noexcept;
+    /**
+     * Sets the header timestamp of a message
+     * @param message Message, whose type must carry a timestamp, see @see{IsStamped}
+     * @param time_ns Time in nanoseconds since the epoch
+    */
+    template<typename _MessageType>
+    void set_stamp_ns(_MessageType& message, int64_t time_ns) noexcept;
+  }
+
+  /**
+   * Histogram of one-way latencies, with power-of-two buckets in microseconds,
+   * fed by subscribers probing the header timestamps of received messages, see @see{Subscriber::set_latency_probe}.
+   *
+   * Latencies are only meaningful when both ends stamp with a clock synchronized to the agent,
+   * see @see{Clock}. Negative latencies, caused by clock offsets, are counted apart.
+  */
+  class LatencyHistogram
+  {
+    public:
+      /**
+       * Amount of buckets. Bucket 0 holds latencies below 2 us, bucket i those from 2^i us to below 2^(i+1) us,
+       * and the last bucket everything longer.
+      */
+      static constexpr size_t BUCKET_COUNT = 24;
+    private:
+      /**
+       * Amount of latencies per bucket
+      */
+      uint32_t _buckets[LatencyHistogram::BUCKET_COUNT] = {};
+      /**
+       * Amount of latencies recorded
+      */
+      uint32_t _count = 0;
+      /**
+       * Amount of negative latencies, not recorded in the buckets
+      */
+      uint32_t _early_count = 0;
+      /**
+       * Sum of latencies recorded, in microseconds
+      */
+      uint64_t _sum_us = 0;
+      /**
+       * Shortest latency recorded, in microseconds
+      */
+      uint32_t _min_us = 0;
+      /**
+       * Longest latency recorded, in microseconds
+      */
+      uint32_t _max_us = 0;
+      /**
+       * Guards the histogram against being recorded and read from several threads at once
+      */
+      mutable threading::Mutex _mutex;
+
+    public:
+      LatencyHistogram(void) noexcept = default;
+      LatencyHistogram(const LatencyHistogram&) = delete;
+
+      /**
+       * Records a latency
+       * @param latency_ns Latency in nanoseconds
+      */
+      void record(int64_t latency_ns) noexcept;
+      /**
+       * Empties the histogram
+      */
+      void reset(void) noexcept;
+
+      /**
+       * Retrieves the amount of latencies recorded, not counting negative ones
+       * @return Amount of latencies
+      */
+      uint32_t get_count(void) const noexcept;
+      /**
+       * Retrieves the amount of negative latencies, which hint at unsynchronized clocks
+       * @return Amount of latencies
+      */
+      uint32_t get_early_count(void) const noexcept;
+      /**
+       * Retrieves the amount of latencies in a bucket
+       * @param index Index of bucket, see @see{BUCKET_COUNT}
+       * @return Amount of latencies
+      */
+      uint32_t get_bucket_count(size_t index) const noexcept;
+      /**
+       * Retrieves the shortest latency recorded
+       * @return Latency in microseconds, zero if none
+      */
+      uint32_t get_min_us(void) const noexcept;
+      /**
+       * Retrieves the average latency recorded
+       * @return Latency in microseconds, zero if none
+      */
+      uint32_t get_mean_us(void) const noexcept;
+      /**
+       * Retrieves the longest latency recorded
+       * @return Latency in microseconds, zero if none
+      */
+      uint32_t get_max_us(void) const noexcept;
+      /**
+       * Retrieves an upper bound of a percentile, from the bucket it falls into
+       * @param percentile Percentile, from 0 to 100
+       * @return Latency in microseconds, zero if none
+      */
+      uint32_t get_percentile_us(float percentile) const noexcept;
+  };
+}
+
+#include "latency_probe_impl.hpp"
\ No newline at end of file
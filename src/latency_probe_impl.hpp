@@ -0,0 +1,38 @@
+#pragma once
+
+#include "latency_probe.hpp"
+
+namespace rclc_cppb
+{
+  namespace latency
+  {
+    template<typename _MessageType>
+    builtin_interfaces__msg__Time& get_stamp(_MessageType& message) noexcept
+    {
+      static_assert(IsStamped<_MessageType>::value, "Message type must carry a std_msgs/Header!");
+      if constexpr(HasHeader<_MessageType>::value)
+      {
+        return message.header.stamp;
+      }
+      else
+      {
+        return message.stamp;
+      }
+    }
+
+    template<typename _MessageType>
+    int64_t get_stamp_ns(const _MessageType& message) noexcept
+    {
+      const builtin_interfaces__msg__Time& stamp = get_stamp(const_cast<_MessageType&>(message));
+      return (int64_t)stamp.sec*1000000000 + (int64_t)stamp.nanosec;
+    }
+
+    template<typename _MessageType>
+    void set_stamp_ns(_MessageType& message, int64_t time_ns) noexcept
+    {
+      builtin_interfaces__msg__Time& stamp = get_stamp(message);
+      stamp.sec = (int32_t)(time_ns/1000000000);
+      stamp.nanosec = (uint32_t)(time_ns%1000000000);
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <micro_ros_arduino.h>
+#include <rcl/rcl.h>
+#include <rcl/error_handling.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+
+#include "message.hpp"
+#include "serialization.hpp"
+#include "node.hpp"
+#include "subscriber.hpp"
+#include "local_subscription.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Subscriber which can also receive messages from publishers on the same device directly, without the agent.
+   * Kept apart from @see{Subscriber}, so that plain subscribers carry no local subscription.
+   *
+   * Usage instructions:
+   * - Instantiate before any node is setup.
+   * - Call subscribe_local() to receive from publishers on the same device, see @see{LocalSubscription}.
+   * - subscribe() still subscribes through the agent, like with @see{Subscriber}.
+   * @param <_MessageType> Message type handled by subscriber
+  */
+  template<typename _MessageType>
+  class LocalSubscriber: public Subscriber<_MessageType>, LocalSubscription
+  {
+    public:
+      /**
+       * Message type handled by subscriber
+      */
+      using MessageType = _MessageType;
+
+      using Subscriber<_MessageType>::Subscriber;
+
+      /**
+       * Subscribes to the topic for publishers on the same device only, which deliver their messages directly.
+       * Nothing goes over the agent, so messages from other devices are not received.
+       * Callbacks of local messages run within the publish call of the publisher.
+       * Fixed-size message types with the Reflection trait implemented are copied into the subscriber,
+       * others are passed to the callback by pointer, so get_last_data and next do not see them.
+       * Does not need the node to be initialized.
+       * @return true if success
+      */
+      bool subscribe_local(void) noexcept;
+    protected:
+      /**
+       * Receives a message published on the same device
+       * @param message Pointer to the published message
+      */
+      void deliver(const void* message) noexcept override;
+  };
+}
+
+#include "local_subscriber_impl.hpp"
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "local_subscriber.hpp"
+
+namespace rclc_cppb
+{
+  template<typename _MessageType>
+  bool LocalSubscriber<_MessageType>::subscribe_local(void) noexcept
+  {
+    Subscriber<MessageType>& subscriber = *this;
+    this->register_local(
+      subscriber.get_node()->node_namespace,
+      subscriber.topic_name,
+      Message<MessageType>::get_type_support()
+    );
+    return true;
+  }
+
+  template<typename _MessageType>
+  void LocalSubscriber<_MessageType>::deliver(const void* message) noexcept
+  {
+    Subscriber<MessageType>& subscriber = *this;
+    if constexpr(Reflect<MessageType>::IS_FIXED_SIZE)
+    {
+      // By copy, so that the message is seen by get_last_data and next like a received one
+      subscriber._message = *(const MessageType*)message;
+      Subscriber<MessageType>::on_message(&subscriber._message, &subscriber);
+    }
+    else
+    {
+      // By pointer, as copying would make sequences share memory with the publisher
+      subscriber.run_callback((const MessageType*)message);
+    }
+  }
+}
\ No newline at end of file
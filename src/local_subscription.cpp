@@ -0,0 +1,168 @@
+#include "local_subscription.hpp"
+
+#include <string.h>
+
+#include "threading.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Characters of a topic name resolved against a node namespace, e.g. /{ namespace }/{ topic name },
+   * produced one at a time so that the resolved name is never built
+  */
+  class ResolvedName
+  {
+    private:
+      /**
+       * Parts which make up the resolved name
+      */
+      const char* _parts[4];
+      /**
+       * Amount of parts
+      */
+      size_t _count = 0;
+      /**
+       * Index of the current part
+      */
+      size_t _index = 0;
+      /**
+       * Next character within the current part
+      */
+      const char* _next = NULL;
+
+    public:
+      /**
+       * Characters of a topic name resolved against a node namespace
+       * @param node_namespace Namespace of the node, with or without leading slash, or NULL
+       * @param topic_name Topic name, absolute if it starts with a slash
+      */
+      ResolvedName(const char* node_namespace, const char* topic_name) noexcept
+      {
+        if(topic_name[0] != '/')
+        {
+          this->_parts[this->_count++] = "/";
+          if(node_namespace != NULL)
+          {
+            while(node_namespace[0] == '/')
+            {
+              node_namespace++;
+            }
+            if(node_namespace[0] != '\0')
+            {
+              this->_parts[this->_count++] = node_namespace;
+              this->_parts[this->_count++] = "/";
+            }
+          }
+        }
+        this->_parts[this->_count++] = topic_name;
+        this->_next = this->_parts[0];
+      }
+
+      /**
+       * Returns the next character, or the null character at the end
+      */
+      char next(void) noexcept
+      {
+        while(*this->_next == '\0')
+        {
+          if(++this->_index >= this->_count)
+          {
+            return '\0';
+          }
+          this->_next = this->_parts[this->_index];
+        }
+        return *this->_next++;
+      }
+  };
+
+  LocalSubscription* LocalSubscription::_first = NULL;
+
+  LocalSubscription::~LocalSubscription() noexcept
+  {
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    for(LocalSubscription** subscription = &LocalSubscription::_first; *subscription != NULL; subscription = &(*subscription)->_next)
+    {
+      if(*subscription == this)
+      {
+        *subscription = this->_next;
+        break;
+      }
+    }
+  }
+
+  void LocalSubscription::register_local(
+    const char* node_namespace,
+    const char* topic_name,
+    const rosidl_message_type_support_t* type_support
+  ) noexcept
+  {
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    if(this->is_local())
+    {
+      return;
+    }
+    this->_node_namespace = node_namespace;
+    this->_topic_name = topic_name;
+    this->_type_support = type_support;
+    this->_next = LocalSubscription::_first;
+    LocalSubscription::_first = this;
+  }
+
+  bool LocalSubscription::is_local(void) const noexcept
+  {
+    return this->_topic_name != NULL;
+  }
+
+  size_t LocalSubscription::deliver_all(
+    const char* node_namespace,
+    const char* topic_name,
+    const rosidl_message_type_support_t* type_support,
+    const void* message
+  ) noexcept
+  {
+    // Recursive, so that a callback publishing again does not deadlock
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    size_t count = 0;
+    // The next subscription is taken first, as a callback may destroy its own subscriber
+    LocalSubscription* next = NULL;
+    for(LocalSubscription* subscription = LocalSubscription::_first; subscription != NULL; subscription = next)
+    {
+      next = subscription->_next;
+      if(
+        subscription->_type_support == type_support &&
+        LocalSubscription::is_same_topic(subscription->_node_namespace, subscription->_topic_name, node_namespace, topic_name)
+      )
+      {
+        subscription->deliver(message);
+        count++;
+      }
+    }
+    return count;
+  }
+
+  bool LocalSubscription::is_same_topic(
+    const char* namespace_a,
+    const char* topic_name_a,
+    const char* namespace_b,
+    const char* topic_name_b
+  ) noexcept
+  {
+    if(topic_name_a == topic_name_b && namespace_a == namespace_b)
+    {
+      return true;
+    }
+    ResolvedName name_a(namespace_a, topic_name_a);
+    ResolvedName name_b(namespace_b, topic_name_b);
+    char character = '\0';
+    do
+    {
+      character = name_a.next();
+      if(character != name_b.next())
+      {
+        return false;
+      }
+    }
+    while(character != '\0');
+    return true;
+  }
+}
\ No newline at end of file
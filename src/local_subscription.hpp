@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <rcl/rcl.h>
+
+namespace rclc_cppb
+{
+  template<typename _MessageType>
+  class Publisher;
+
+  /**
+   * A subscription which receives messages from publishers on the same device directly, without the agent.
+   *
+   * All local subscriptions are kept in an intrusive list, keyed by topic name and type support,
+   * so no heap allocation takes place. A publisher delivers to every local subscription
+   * whose topic name and type support match its own, within the call to publish.
+   * Topic names are compared fully resolved against the namespace of their node,
+   * so relative and absolute names of the same topic match, and equal names in different namespaces do not.
+   * The list is guarded by the spin mutex, which is recursive, so callbacks may publish again.
+  */
+  class LocalSubscription
+  {
+    private:
+      /**
+       * First local subscription in the list
+      */
+      static LocalSubscription* _first;
+      /**
+       * Next local subscription in the list
+      */
+      LocalSubscription* _next = NULL;
+      /**
+       * Namespace of the node the topic name is relative to
+      */
+      const char* _node_namespace = NULL;
+      /**
+       * Topic name, or NULL while not registered
+      */
+      const char* _topic_name = NULL;
+      /**
+       * Type support of the message type
+      */
+      const rosidl_message_type_support_t* _type_support = NULL;
+
+    protected:
+      /**
+       * A subscription which receives messages from publishers on the same device directly.
+       * Not registered until @see{register_local} is called.
+      */
+      LocalSubscription(void) noexcept = default;
+      /**
+       * Removes itself from the list of local subscriptions
+      */
+      ~LocalSubscription() noexcept;
+
+      /**
+       * Adds itself to the list of local subscriptions, unless already registered
+       * @param node_namespace Namespace of the node the topic name is relative to
+       * @param topic_name Topic name
+       * @param type_support Type support of the message type
+      */
+      void register_local(
+        const char* node_namespace,
+        const char* topic_name,
+        const rosidl_message_type_support_t* type_support
+      ) noexcept;
+      /**
+       * Returns true if registered as a local subscription
+      */
+      bool is_local(void) const noexcept;
+
+      /**
+       * Called with every message published locally on the topic
+       * @param message Pointer to the published message, valid only during the call
+      */
+      virtual void deliver(const void* message) noexcept = 0;
+    private:
+      /**
+       * Delivers a message to every local subscription with matching topic name and type support
+       * @param node_namespace Namespace of the node of the publisher
+       * @param topic_name Topic name
+       * @param type_support Type support of the message type
+       * @param message Pointer to the published message
+       * @return Amount of local subscriptions delivered to
+      */
+      static size_t deliver_all(
+        const char* node_namespace,
+        const char* topic_name,
+        const rosidl_message_type_support_t* type_support,
+        const void* message
+      ) noexcept;
+      /**
+       * Returns true if two topic names resolve to the same topic, without building the resolved names
+       * @param namespace_a Namespace of the node of the first topic name
+       * @param topic_name_a First topic name
+       * @param namespace_b Namespace of the node of the second topic name
+       * @param topic_name_b Second topic name
+      */
+      static bool is_same_topic(
+        const char* namespace_a,
+        const char* topic_name_a,
+        const char* namespace_b,
+        const char* topic_name_b
+      ) noexcept;
+
+      template<typename _MessageType>
+      friend class Publisher;
+  };
+}
\ No newline at end of file
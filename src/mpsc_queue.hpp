@@ -0,0 +1,101 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <atomic>
+
+namespace rclc_cppb
+{
+  /**
+   * Fixed-capacity lock-free queue with many producers and a single consumer.
+   *
+   * Pushing never blocks and never allocates, so it is safe from interrupt service routines and other threads.
+   * When the queue is full, the pushed value is dropped and counted as an overflow.
+   * Popping must only take place from a single thread, e.g. the one spinning the executor.
+   *
+   * Each slot carries a sequence number, which tells producers and the consumer whose turn it is,
+   * so that a producer interrupted mid-push never blocks anyone else.
+   * @param <_ValueType> Type of queued values, which must be trivially copyable
+   * @param <CAPACITY> Maximum amount of queued values, which must be a power of two
+  */
+  template<typename _ValueType, size_t CAPACITY>
+  class MpscQueue
+  {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two!");
+
+    public:
+      /**
+       * Type of queued values
+      */
+      using ValueType = _ValueType;
+    private:
+      /**
+       * A slot holding one value
+      */
+      struct Slot
+      {
+        /**
+         * Equals the push position when free, and the push position plus one when holding a value
+        */
+        std::atomic<size_t> sequence;
+        /**
+         * Value
+        */
+        ValueType value;
+      };
+
+      /**
+       * Slots, indexed by position modulo capacity
+      */
+      Slot _slots[CAPACITY];
+      /**
+       * Position of next push
+      */
+      std::atomic<size_t> _push_position;
+      /**
+       * Position of next pop
+      */
+      size_t _pop_position = 0;
+      /**
+       * Amount of values dropped because the queue was full
+      */
+      std::atomic<uint32_t> _overflow_count;
+
+    public:
+      /**
+       * Fixed-capacity lock-free queue with many producers and a single consumer.
+       * @param <_ValueType> Type of queued values
+       * @param <CAPACITY> Maximum amount of queued values, which must be a power of two
+      */
+      MpscQueue(void) noexcept;
+
+      /**
+       * Pushes a value onto the queue.
+       * Safe to call from interrupt service routines and any thread.
+       * @param value Value
+       * @return false if the queue was full and the value was dropped
+      */
+      bool push(const ValueType& value) noexcept;
+      /**
+       * Pops the oldest value from the queue.
+       * Must only be called from a single thread.
+       * @param value Set to the popped value
+       * @return false if the queue was empty
+      */
+      bool pop(ValueType& value) noexcept;
+      /**
+       * Returns true if there is no value ready to pop.
+       * Must only be called from the thread popping.
+      */
+      bool is_empty(void) const noexcept;
+
+      /**
+       * Retrieves the amount of values dropped because the queue was full
+       * @return Amount of values
+      */
+      uint32_t get_overflow_count(void) const noexcept;
+  };
+}
+
+#include "mpsc_queue_impl.hpp"
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "mpsc_queue.hpp"
+
+namespace rclc_cppb
+{
+  template<typename _ValueType, size_t CAPACITY>
+  MpscQueue<_ValueType, CAPACITY>::MpscQueue(void) noexcept:
+    _push_position(0),
+    _overflow_count(0)
+  {
+    for(size_t i = 0; i < CAPACITY; i++)
+    {
+      this->_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  template<typename _ValueType, size_t CAPACITY>
+  bool MpscQueue<_ValueType, CAPACITY>::push(const ValueType& value) noexcept
+  {
+    size_t position = this->_push_position.load(std::memory_order_relaxed);
+    Slot* slot;
+    while(true)
+    {
+      slot = &this->_slots[position & (CAPACITY - 1)];
+      const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const ptrdiff_t difference = (ptrdiff_t)sequence - (ptrdiff_t)position;
+      if(difference == 0)
+      {
+        // Claims the slot, or reloads the position if another producer was faster
+        if(this->_push_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if(difference < 0)
+      {
+        this->_overflow_count.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      else
+      {
+        position = this->_push_position.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = value;
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  template<typename _ValueType, size_t CAPACITY>
+  bool MpscQueue<_ValueType, CAPACITY>::pop(ValueType& value) noexcept
+  {
+    Slot& slot = this->_slots[this->_pop_position & (CAPACITY - 1)];
+    const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    // Also false while a producer has claimed the slot but not finished writing it
+    if(sequence != this->_pop_position + 1)
+    {
+      return false;
+    }
+    value = slot.value;
+    slot.sequence.store(this->_pop_position + CAPACITY, std::memory_order_release);
+    this->_pop_position++;
+    return true;
+  }
+
+  template<typename _ValueType, size_t CAPACITY>
+  bool MpscQueue<_ValueType, CAPACITY>::is_empty(void) const noexcept
+  {
+    const Slot& slot = this->_slots[this->_pop_position & (CAPACITY - 1)];
+    return slot.sequence.load(std::memory_order_acquire) != this->_pop_position + 1;
+  }
+
+  template<typename _ValueType, size_t CAPACITY>
+  uint32_t MpscQueue<_ValueType, CAPACITY>::get_overflow_count(void) const noexcept
+  {
+    return this->_overflow_count.load(std::memory_order_relaxed);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+#ifndef RCLC_CPPB__MULTI_ARRAY_H_
+  #define RCLC_CPPB__MULTI_ARRAY_H_
+
+  #include <rcl/rcl.h>
+  #include <rcl/error_handling.h>
+  #include <rclc/rclc.h>
+  #include <rclc/executor.h>
+
+  #include <std_msgs/msg/multi_array_layout.h>
+
+  #include "message.hpp"
+
+  namespace rclc_cppb
+  {
+    /**
+     * MultiArray trait.
+     *
+     * Maps an element type onto the std_msgs MultiArray message type carrying a sequence of that element type,
+     * and gives uniform access to the sequence and layout of the message.
+     *
+     * Implemented for all MultiArray types in std_msgs that are included before this library.
+     * uint8_t maps to UInt8MultiArray, not ByteMultiArray.
+     *
+     * @param <_ElementType> The element-type for which the trait is implemented
+    */
+    template<typename _ElementType>
+    struct MultiArray
+    {
+      /**
+       * Public export of _ElementType
+      */
+      using ElementType = _ElementType;
+      /**
+       * MultiArray message-type carrying elements of this type
+       *
+       * Please override this with the message-type in implementation
+      */
+      struct MessageType;
+
+      /**
+       * true if trait is implemented
+       *
+       * Please override this and set to true in implementation
+      */
+      constexpr static const bool IS_IMPL = false;
+
+      /**
+       * Retrieves pointer to the elements of the message
+       * @param message Message
+       * @return Pointer to first element
+      */
+      static ElementType* get_elements(MessageType& message) noexcept;
+      /**
+       * Retrieves pointer to the elements of the message
+       * @param message Message
+       * @return Pointer to first element
+      */
+      static const ElementType* get_elements(const MessageType& message) noexcept;
+      /**
+       * Retrieves the amount of elements in the message
+       * @param message Message
+       * @return Amount of elements
+      */
+      static size_t get_size(const MessageType& message) noexcept;
+      /**
+       * Retrieves the amount of elements the message has memory for
+       * @param message Message
+       * @return Element capacity
+      */
+      static size_t get_capacity(const MessageType& message) noexcept;
+      /**
+       * Sets the amount of elements in the message. Must not exceed the capacity.
+       * @param message Message
+       * @param size Amount of elements
+      */
+      static void set_size(MessageType& message, size_t size) noexcept;
+      /**
+       * Points the element sequence of the message at preallocated memory.
+       * The message does not take ownership of the memory.
+       * @param message Message
+       * @param elements Pointer to element memory
+       * @param capacity Amount of elements the memory has room for
+      */
+      static void set_memory(MessageType& message, ElementType* elements, size_t capacity) noexcept;
+      /**
+       * Retrieves reference to the layout of the message
+       * @param message Message
+       * @return Reference to layout
+      */
+      static std_msgs__msg__MultiArrayLayout& get_layout(MessageType& message) noexcept;
+      /**
+       * Retrieves reference to the layout of the message
+       * @param message Message
+       * @return Reference to layout
+      */
+      static const std_msgs__msg__MultiArrayLayout& get_layout(const MessageType& message) noexcept;
+    };
+  }
+
+  #define MULTI_ARRAY_IMPL(ELEMENT_TYPE, MESSAGE_TYPE) \
+  template<> \
+  struct rclc_cppb::MultiArray<ELEMENT_TYPE> \
+  { \
+    using ElementType = ELEMENT_TYPE; \
+    using MessageType = MESSAGE_TYPE; \
+     \
+    constexpr static const bool IS_IMPL = true; \
+     \
+    static ElementType* get_elements(MessageType& message) noexcept \
+    { \
+      return message.data.data; \
+    } \
+    static const ElementType* get_elements(const MessageType& message) noexcept \
+    { \
+      return message.data.data; \
+    } \
+    static size_t get_size(const MessageType& message) noexcept \
+    { \
+      return message.data.size; \
+    } \
+    static size_t get_capacity(const MessageType& message) noexcept \
+    { \
+      return message.data.capacity; \
+    } \
+    static void set_size(MessageType& message, size_t size) noexcept \
+    { \
+      message.data.size = size; \
+    } \
+    static void set_memory(MessageType& message, ElementType* elements, size_t capacity) noexcept \
+    { \
+      message.data.data = elements; \
+      message.data.size = 0; \
+      message.data.capacity = capacity; \
+    } \
+    static std_msgs__msg__MultiArrayLayout& get_layout(MessageType& message) noexcept \
+    { \
+      return message.layout; \
+    } \
+    static const std_msgs__msg__MultiArrayLayout& get_layout(const MessageType& message) noexcept \
+    { \
+      return message.layout; \
+    } \
+  };
+#endif
+
+#if defined(STD_MSGS__MSG__U_INT8_MULTI_ARRAY_H_) && !defined(RCLC_CPPB__MULTI_ARRAY_H__U_INT8_)
+  #define RCLC_CPPB__MULTI_ARRAY_H__U_INT8_
+  MULTI_ARRAY_IMPL(uint8_t, std_msgs__msg__UInt8MultiArray)
+#endif
+#if defined(STD_MSGS__MSG__U_INT16_MULTI_ARRAY_H_) && !defined(RCLC_CPPB__MULTI_ARRAY_H__U_INT16_)
+  #define RCLC_CPPB__MULTI_ARRAY_H__U_INT16_
+  MULTI_ARRAY_IMPL(uint16_t, std_msgs__msg__UInt16MultiArray)
+#endif
+#if defined(STD_MSGS__MSG__U_INT32_MULTI_ARRAY_H_) && !defined(RCLC_CPPB__MULTI_ARRAY_H__U_INT32_)
+  #define RCLC_CPPB__MULTI_ARRAY_H__U_INT32_
+  MULTI_ARRAY_IMPL(uint32_t, std_msgs__msg__UInt32MultiArray)
+#endif
+#if defined(STD_MSGS__MSG__U_INT64_MULTI_ARRAY_H_) && !defined(RCLC_CPPB__MULTI_ARRAY_H__U_INT64_)
+  #define RCLC_CPPB__MULTI_ARRAY_H__U_INT64_
+  MULTI_ARRAY_IMPL(uint64_t, std_msgs__msg__UInt64MultiArray)
+#endif
+
+#if defined(STD_MSGS__MSG__INT8_MULTI_ARRAY_H_) && !defined(RCLC_CPPB__MULTI_ARRAY_H__INT8_)
+  #define RCLC_CPPB__MULTI_ARRAY_H__INT8_
+  MULTI_ARRAY_IMPL(int8_t, std_msgs__msg__Int8MultiArray)
+#endif
+#if defined(STD_MSGS__MSG__INT16_MULTI_ARRAY_H_) && !defined(RCLC_CPPB__MULTI_ARRAY_H__INT16_)
+  #define RCLC_CPPB__MULTI_ARRAY_H__INT16_
+  MULTI_ARRAY_IMPL(int16_t, std_msgs__msg__Int16MultiArray)
+#endif
+#if defined(STD_MSGS__MSG__INT32_MULTI_ARRAY_H_) && !defined(RCLC_CPPB__MULTI_ARRAY_H__INT32_)
+  #define RCLC_CPPB__MULTI_ARRAY_H__INT32_
+  MULTI_ARRAY_IMPL(int32_t, std_msgs__msg__Int32MultiArray)
+#endif
+#if defined(STD_MSGS__MSG__INT64_MULTI_ARRAY_H_) && !defined(RCLC_CPPB__MULTI_ARRAY_H__INT64_)
+  #define RCLC_CPPB__MULTI_ARRAY_H__INT64_
+  MULTI_ARRAY_IMPL(int64_t, std_msgs__msg__Int64MultiArray)
+#endif
+
+#if defined(STD_MSGS__MSG__FLOAT32_MULTI_ARRAY_H_) && !defined(RCLC_CPPB__MULTI_ARRAY_H__FLOAT32_)
+  #define RCLC_CPPB__MULTI_ARRAY_H__FLOAT32_
+  MULTI_ARRAY_IMPL(float, std_msgs__msg__Float32MultiArray)
+#endif
+#if defined(STD_MSGS__MSG__FLOAT64_MULTI_ARRAY_H_) && !defined(RCLC_CPPB__MULTI_ARRAY_H__FLOAT64_)
+  #define RCLC_CPPB__MULTI_ARRAY_H__FLOAT64_
+  MULTI_ARRAY_IMPL(double, std_msgs__msg__Float64MultiArray)
+#endif
\ No newline at end of file
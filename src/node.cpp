@@ -6,8 +6,25 @@
 #include <rcl/error_handling.h>
 #include <rclc/rclc.h>
 #include <rclc/executor.h>
+#include <rmw_microros/rmw_microros.h>
 
 #include "error.hpp"
+#include "spin_hook.hpp"
+#include "handle.hpp"
+#include "guard_condition.hpp"
+#include "trace.hpp"
+
+#ifdef RCLC_CPPB_THREADS
+  #include <condition_variable>
+  #include <chrono>
+#endif
+#if defined(__linux__)
+  #include <poll.h>
+  #include <unistd.h>
+  #include <sys/eventfd.h>
+#elif defined(ARDUINO_ARCH_MBED)
+  #include <cmsis.h>
+#endif
 
 // https://micro.ros.org/docs/tutorials/programming_rcl_rclc/node/
 // https://micro.ros.org/docs/tutorials/programming_rcl_rclc/executor/#example-1-hello-world
@@ -31,7 +48,6 @@ namespace rclc_cppb
     };
   #endif
 
-  unsigned int _num_handles = 0;
   rcl_allocator_t _allocator;
   rclc_support_t _support;
   rclc_executor_t _executor;
@@ -45,16 +61,116 @@ namespace rclc_cppb
   };
   InitStage _init_stage = InitStage::NEW;
 
+  Node::ReadyCallback _ready_callback = NULL;
+  #if defined(__linux__)
+    int _ready_fd = -1;
+
+    /**
+     * Retrieves the eventfd written by @see{Node::notify}, so that a notification from another thread wakes the poll
+     * @return File descriptor, or -1 if it could not be created
+    */
+    static int get_notify_fd(void) noexcept
+    {
+      static const int notify_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      return notify_fd;
+    }
+  #endif
+  threading::Flag _is_notified(false);
+  #ifdef RCLC_CPPB_THREADS
+    /**
+     * Wakes the threads of threaded nodes, counting wakes so that none is missed while a thread is spinning
+    */
+    std::mutex _thread_wake_mutex;
+    std::condition_variable _thread_wake;
+    uint32_t _thread_wake_count = 0;
+
+    /**
+     * Wakes the threads of all threaded nodes from their wait between spins
+    */
+    static void wake_threads(void) noexcept
+    {
+      {
+        std::lock_guard<std::mutex> lock(_thread_wake_mutex);
+        _thread_wake_count++;
+      }
+      _thread_wake.notify_all();
+    }
+  #endif
+  SpinStats _spin_stats = {};
+
+  rcl_allocator_t _executor_allocator;
+  bool _has_executor_allocator = false;
+  unsigned int _static_num_handles = 0;
+
+  uint32_t _client_key = 0;
+
+  /**
+   * Derives a client key from an id unique to the device, so that identical boards running identical firmware differ
+   * @return Client key, or 0 if the device has no unique id
+  */
+  static uint32_t derive_client_key(void) noexcept
+  {
+    #if defined(UID_BASE)
+      // 96-bit unique device id of STM32 chips, e.g. the STM32H747 of the Portenta H7
+      const volatile uint32_t* const uid = (const volatile uint32_t*)UID_BASE;
+      uint32_t key = uid[0];
+      key = (key ^ uid[1])*2654435761u;
+      key = (key ^ uid[2])*2246822519u;
+    #elif defined(__linux__)
+      // Host only, as the process id changes with every restart
+      uint32_t key = (uint32_t)gethostid();
+      key *= 2654435761u;
+    #else
+      return 0;
+    #endif
+    key ^= key >> 16;
+    // 0 means no key
+    return key != 0 ? key : 1u;
+  }
+
+  uint64_t _loop_budget_ns = Node::DEFAULT_LOOP_BUDGET_NS;
+  unsigned long _last_adaptive_spin_us = 0;
+
+  Node* Node::_first = NULL;
+
   Node::Node(const char *node_name, const char *node_namespace) noexcept:
     node_name(node_name),
-    node_namespace(node_namespace)
+    node_namespace(node_namespace),
+    _next(Node::_first)
   {
-
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    Node::_first = this;
   }
   Node::~Node() noexcept
   {
     this->on_kill();
 
+    #ifdef RCLC_CPPB_THREADS
+      this->stop_thread();
+    #endif
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    for(Node** node = &Node::_first; *node != NULL; node = &(*node)->_next)
+    {
+      if(*node == this)
+      {
+        *node = this->_next;
+        break;
+      }
+    }
+
+    #ifdef RCLC_CPPB_THREADS
+      if(this->_is_executor_init)
+      {
+        this->_is_executor_init = false;
+        rclc_cppb::error::handled_call<
+          decltype(&rclc_executor_fini),
+          &rclc_executor_fini
+        >(
+          &this->_executor
+        );
+      }
+    #endif
+
     this->_is_node_init = false;
     rclc_cppb::_init_stage = InitStage::NEW;
 
@@ -92,9 +208,100 @@ namespace rclc_cppb
       this->_is_node_init = true;
     }
 
-    return this->on_setup();
+    #ifdef RCLC_CPPB_THREADS
+      if(this->_is_threaded && !this->_is_executor_init)
+      {
+        this->_executor = rclc_executor_get_zero_initialized_executor();
+        if(
+          !rclc_cppb::error::handled_call<
+            decltype(&rclc_executor_init),
+            &rclc_executor_init
+          >(
+            &this->_executor,
+            &rclc_cppb::_support.context,
+            this->_num_node_handles,
+            &rclc_cppb::_allocator
+          )
+        )
+        {
+          return false;
+        }
+        this->_is_executor_init = true;
+      }
+    #endif
+
+    if(!this->on_setup())
+    {
+      return false;
+    }
+
+    #ifdef RCLC_CPPB_THREADS
+      if(this->_is_threaded && !this->_is_thread_running)
+      {
+        this->_is_thread_running = true;
+        this->_thread = std::thread([this](void)
+        {
+          while(this->_is_thread_running)
+          {
+            uint32_t wake_count;
+            {
+              std::lock_guard<std::mutex> lock(rclc_cppb::_thread_wake_mutex);
+              wake_count = rclc_cppb::_thread_wake_count;
+            }
+            {
+              // Every executor shares the XRCE session, so spins of the thread, of spin_once and publishes take turns.
+              // Held only for a spin without waiting, so that the others never wait for this thread to find work.
+              threading::RecursiveLock lock(threading::get_spin_mutex());
+              RCLC_CPPB_TRACE(SPIN_BEGIN, this->node_name, 0);
+              GuardCondition::trigger_pending();
+              const rcl_ret_t return_code = rclc_executor_spin_some(&this->_executor, 0);
+              // Nothing arriving is no failure to record
+              const bool success =
+                return_code != RCL_RET_TIMEOUT &&
+                rclc_cppb::error::handle<
+                  decltype(&rclc_executor_spin_some),
+                  &rclc_executor_spin_some
+                >(return_code);
+              RCLC_CPPB_TRACE(SPIN_END, this->node_name, success);
+            }
+            // Waits outside of the lock, woken early by notify and triggered guard conditions
+            std::unique_lock<std::mutex> lock(rclc_cppb::_thread_wake_mutex);
+            rclc_cppb::_thread_wake.wait_for(
+              lock,
+              std::chrono::nanoseconds(this->_thread_poll_period_ns),
+              [this, wake_count](void)
+              {
+                return !this->_is_thread_running || rclc_cppb::_thread_wake_count != wake_count;
+              }
+            );
+          }
+        });
+      }
+    #endif
+    return true;
   }
 
+  #ifdef RCLC_CPPB_THREADS
+    void Node::set_threaded(uint64_t poll_period_ns) noexcept
+    {
+      this->_is_threaded = true;
+      this->_thread_poll_period_ns = poll_period_ns;
+    }
+    void Node::stop_thread(void) noexcept
+    {
+      this->_is_thread_running = false;
+      rclc_cppb::wake_threads();
+      if(this->_thread.joinable())
+      {
+        this->_thread.join();
+      }
+    }
+    bool Node::is_threaded(void) const noexcept
+    {
+      return this->_is_threaded;
+    }
+  #endif
+
   void Node::loop(void) noexcept {}
 
   bool Node::spin_once(uint64_t timeout_ns) noexcept
@@ -103,19 +310,232 @@ namespace rclc_cppb
     {
       return false;
     }
-    if(
-      !rclc_cppb::error::handled_call<
+    #ifdef RCLC_CPPB_THREADS
+      std::unique_lock<threading::RecursiveMutex> lock(threading::get_spin_mutex(), std::defer_lock);
+      if(timeout_ns == 0)
+      {
+        // Another thread is spinning already, which does the work of this spin as well
+        if(!lock.try_lock())
+        {
+          return true;
+        }
+      }
+      else
+      {
+        lock.lock();
+      }
+    #endif
+    const bool is_adaptive = timeout_ns == Node::ADAPTIVE_SPIN_TIMEOUT;
+    if(is_adaptive)
+    {
+      timeout_ns = Node::get_adaptive_timeout_ns();
+    }
+    RCLC_CPPB_TRACE(SPIN_BEGIN, "spin_once", 0);
+    GuardCondition::trigger_pending();
+    const rcl_ret_t return_code = rclc_executor_spin_some(Node::get_executor_mut(), timeout_ns);
+    // Spins time out whenever nothing arrives, which is no failure to record
+    const bool success =
+      return_code != RCL_RET_TIMEOUT &&
+      rclc_cppb::error::handle<
         decltype(&rclc_executor_spin_some),
         &rclc_executor_spin_some
-      >(
-        Node::get_executor_mut(),
-        timeout_ns
-      )
-    )
+      >(return_code);
+    SpinHook::run_all();
+    RCLC_CPPB_TRACE(SPIN_END, "spin_once", success);
+    if(is_adaptive)
+    {
+      rclc_cppb::_last_adaptive_spin_us = micros();
+    }
+    return success;
+  }
+
+  bool Node::spin_when_ready(uint64_t timeout_ns) noexcept
+  {
+    if(rclc_cppb::_init_stage < InitStage::EXECUTOR_DONE)
     {
       return false;
     }
-    return true;
+    bool has_source = rclc_cppb::_ready_callback != NULL;
+    #if defined(__linux__)
+      has_source = has_source || rclc_cppb::_ready_fd >= 0;
+    #endif
+    if(!has_source)
+    {
+      return Node::spin_once(timeout_ns);
+    }
+
+    const bool is_adaptive = timeout_ns == Node::ADAPTIVE_SPIN_TIMEOUT;
+    if(is_adaptive)
+    {
+      timeout_ns = Node::get_adaptive_timeout_ns();
+    }
+    const unsigned long timeout_us = (unsigned long)(timeout_ns/1000);
+    const unsigned long start_us = micros();
+    bool is_woken = Node::is_ready();
+    while(!is_woken)
+    {
+      const unsigned long elapsed_us = micros() - start_us;
+      if(elapsed_us >= timeout_us)
+      {
+        break;
+      }
+      Node::idle(timeout_us - elapsed_us);
+      is_woken = Node::is_ready();
+    }
+    const unsigned long wake_us = micros();
+    rclc_cppb::_is_notified = false;
+    #if defined(__linux__)
+      uint64_t notification_count;
+      (void)read(get_notify_fd(), &notification_count, sizeof(notification_count));
+    #endif
+
+    // Everything due is ready by now, so the executor is not allowed to wait
+    const bool success = Node::spin_once(0);
+
+    const unsigned long done_us = micros();
+    if(is_adaptive)
+    {
+      rclc_cppb::_last_adaptive_spin_us = done_us;
+    }
+    rclc_cppb::_spin_stats.idle_us += wake_us - start_us;
+    rclc_cppb::_spin_stats.busy_us += done_us - wake_us;
+    if(is_woken)
+    {
+      rclc_cppb::_spin_stats.wake_count++;
+      rclc_cppb::_spin_stats.last_wake_latency_us = done_us - wake_us;
+      if(rclc_cppb::_spin_stats.last_wake_latency_us > rclc_cppb::_spin_stats.max_wake_latency_us)
+      {
+        rclc_cppb::_spin_stats.max_wake_latency_us = rclc_cppb::_spin_stats.last_wake_latency_us;
+      }
+    }
+    return success;
+  }
+
+  void Node::use_static_executor(rcl_allocator_t allocator, unsigned int handle_count) noexcept
+  {
+    rclc_cppb::_executor_allocator = allocator;
+    rclc_cppb::_has_executor_allocator = true;
+    rclc_cppb::_static_num_handles = handle_count;
+  }
+
+  void Node::set_client_key(uint32_t key) noexcept
+  {
+    rclc_cppb::_client_key = key;
+  }
+  uint32_t Node::get_client_key(void) noexcept
+  {
+    return rclc_cppb::_client_key;
+  }
+
+  void Node::set_loop_budget_ns(uint64_t budget_ns) noexcept
+  {
+    rclc_cppb::_loop_budget_ns = budget_ns;
+  }
+  uint64_t Node::get_adaptive_timeout_ns(void) noexcept
+  {
+    const uint64_t elapsed_ns = RCL_US_TO_NS((uint64_t)(micros() - rclc_cppb::_last_adaptive_spin_us));
+    const uint64_t remaining_ns = elapsed_ns < rclc_cppb::_loop_budget_ns ? rclc_cppb::_loop_budget_ns - elapsed_ns : 0;
+    const uint64_t due_ns = SpinHook::get_time_until_next_due_ns();
+    return due_ns < remaining_ns ? due_ns : remaining_ns;
+  }
+
+  void Node::set_ready_callback(ReadyCallback callback) noexcept
+  {
+    rclc_cppb::_ready_callback = callback;
+  }
+  #if defined(__linux__)
+    void Node::set_ready_fd(int fd) noexcept
+    {
+      rclc_cppb::_ready_fd = fd;
+    }
+  #endif
+  void Node::notify(void) noexcept
+  {
+    rclc_cppb::_is_notified = true;
+    #ifdef RCLC_CPPB_THREADS
+      rclc_cppb::wake_threads();
+    #endif
+    #if defined(__linux__)
+      const uint64_t notification_count = 1;
+      (void)write(get_notify_fd(), &notification_count, sizeof(notification_count));
+    #endif
+  }
+  const SpinStats& Node::get_spin_stats(void) noexcept
+  {
+    return rclc_cppb::_spin_stats;
+  }
+  void Node::reset_spin_stats(void) noexcept
+  {
+    rclc_cppb::_spin_stats = SpinStats();
+  }
+
+  const error::CallSite* Node::get_failed_calls(void) noexcept
+  {
+    return error::CallSite::get_first();
+  }
+  uint32_t Node::get_failure_count(void) noexcept
+  {
+    return error::get_failure_count();
+  }
+  bool Node::get_recent_failure(size_t index, error::Failure* failure) noexcept
+  {
+    return error::get_recent_failure(index, failure);
+  }
+  void Node::reset_failures(void) noexcept
+  {
+    error::reset_failures();
+  }
+
+  bool Node::is_ready(void) noexcept
+  {
+    if(rclc_cppb::_is_notified)
+    {
+      return true;
+    }
+    if(rclc_cppb::_ready_callback != NULL && rclc_cppb::_ready_callback())
+    {
+      return true;
+    }
+    #if defined(__linux__)
+      if(rclc_cppb::_ready_fd >= 0)
+      {
+        pollfd descriptor = {rclc_cppb::_ready_fd, POLLIN, 0};
+        return poll(&descriptor, 1, 0) > 0;
+      }
+    #endif
+    return false;
+  }
+  void Node::idle(unsigned long timeout_us) noexcept
+  {
+    #if defined(__linux__)
+      pollfd descriptors[2] = {
+        {get_notify_fd(), POLLIN, 0},
+        {rclc_cppb::_ready_fd, POLLIN, 0}
+      };
+      int timeout_ms = (int)((timeout_us + 999)/1000);
+      if(rclc_cppb::_ready_fd < 0 && timeout_ms > 1)
+      {
+        // Only the ready callback tells whether the transport is ready, so it is checked again every millisecond
+        timeout_ms = 1;
+      }
+      // Negative descriptors are ignored by poll
+      poll(descriptors, 2, timeout_ms);
+    #elif defined(__arm__)
+      // Any interrupt wakes the processor, including the receive interrupt of the transport and the system tick
+      (void)timeout_us;
+      __asm__ volatile("wfi");
+    #else
+      // Without wfi, sleeping a millisecond at a time still lets RTOS-based cores such as the ESP32 run their idle task,
+      // while the ready callback is checked in between
+      if(timeout_us >= 1000)
+      {
+        delay(1);
+      }
+      else
+      {
+        yield();
+      }
+    #endif
   }
 
   const rcl_node_t* Node::get_handle(void) const noexcept
@@ -134,6 +554,20 @@ namespace rclc_cppb
   {
     return &rclc_cppb::_executor;
   }
+  rclc_executor_t* Node::get_node_executor_mut(void) noexcept
+  {
+    #ifdef RCLC_CPPB_THREADS
+      if(this->_is_threaded)
+      {
+        return &this->_executor;
+      }
+    #endif
+    return &rclc_cppb::_executor;
+  }
+  rcl_context_t* Node::get_context_mut(void) noexcept
+  {
+    return &rclc_cppb::_support.context;
+  }
   bool Node::has_namespace(void) const noexcept
   {
     return this->node_namespace != NULL && strlen(this->node_namespace) != 0;
@@ -157,6 +591,80 @@ namespace rclc_cppb
   }
   void Node::on_kill(void) noexcept {}
 
+  bool Node::is_session_up(void) noexcept
+  {
+    return rclc_cppb::_init_stage == InitStage::EXECUTOR_DONE;
+  }
+
+  void Node::teardown_session(void) noexcept
+  {
+    #ifdef RCLC_CPPB_THREADS
+      for(Node* node = Node::_first; node != NULL; node = node->_next)
+      {
+        node->stop_thread();
+      }
+    #endif
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+
+    // Errors are expected from here on, as the agent is gone, so they are ignored instead of handled
+    if(rclc_cppb::_init_stage >= InitStage::SUPPORT_DONE)
+    {
+      // Entities are destroyed without waiting for the agent to confirm
+      (void)rmw_uros_set_context_entity_destroy_session_timeout(
+        rcl_context_get_rmw_context(&rclc_cppb::_support.context),
+        0
+      );
+    }
+    Handle::lose_all();
+    for(Node* node = Node::_first; node != NULL; node = node->_next)
+    {
+      #ifdef RCLC_CPPB_THREADS
+        if(node->_is_executor_init)
+        {
+          node->_is_executor_init = false;
+          (void)rclc_executor_fini(&node->_executor);
+        }
+      #endif
+      if(node->_is_node_init)
+      {
+        node->_is_node_init = false;
+        node->_is_lost = true;
+        (void)rcl_node_fini(&node->_node);
+      }
+    }
+    if(rclc_cppb::_init_stage >= InitStage::EXECUTOR_DONE)
+    {
+      (void)rclc_executor_fini(&rclc_cppb::_executor);
+      rclc_cppb::_executor = rclc_executor_get_zero_initialized_executor();
+    }
+    if(rclc_cppb::_init_stage >= InitStage::SUPPORT_DONE)
+    {
+      (void)rclc_support_fini(&rclc_cppb::_support);
+    }
+    // The transports and allocator are kept, so only the session is created again
+    if(rclc_cppb::_init_stage > InitStage::ALLOCATOR_DONE)
+    {
+      rclc_cppb::_init_stage = InitStage::ALLOCATOR_DONE;
+    }
+  }
+
+  bool Node::restore_session(void) noexcept
+  {
+    for(Node* node = Node::_first; node != NULL; node = node->_next)
+    {
+      if(!node->_is_lost)
+      {
+        continue;
+      }
+      if(!node->setup())
+      {
+        return false;
+      }
+      node->_is_lost = false;
+    }
+    return Handle::restore_all();
+  }
+
   bool Node::init(void) noexcept
   {
     static_assert(InitStage::NEW < InitStage::ALLOCATOR_DONE);
@@ -170,17 +678,55 @@ namespace rclc_cppb
     static_assert(InitStage::ALLOCATOR_DONE < InitStage::SUPPORT_DONE);
     if(rclc_cppb::_init_stage < InitStage::SUPPORT_DONE)
     {
+      if(rclc_cppb::_client_key == 0)
+      {
+        // Derived once, then kept so that every following session is recognised by the agent as the same client
+        rclc_cppb::_client_key = derive_client_key();
+      }
+
+      rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
       if(
         !rclc_cppb::error::handled_call<
-          decltype(&rclc_support_init),
-          &rclc_support_init
+          decltype(&rcl_init_options_init),
+          &rcl_init_options_init
+        >(
+          &init_options,
+          rclc_cppb::_allocator
+        )
+      )
+      {
+        return false;
+      }
+      // Without a key rmw picks a random one for each session, as no stable one can be told apart from other boards
+      const bool success =
+        (
+          rclc_cppb::_client_key == 0 ||
+          rclc_cppb::error::handled_call<
+            decltype(&rmw_uros_options_set_client_key),
+            &rmw_uros_options_set_client_key
+          >(
+            rclc_cppb::_client_key,
+            rcl_init_options_get_rmw_init_options(&init_options)
+          )
+        ) &&
+        rclc_cppb::error::handled_call<
+          decltype(&rclc_support_init_with_options),
+          &rclc_support_init_with_options
         >(
           &rclc_cppb::_support,
           rclc_cppb::ARGUMENTS_COUNT,
           rclc_cppb::ARGUMENTS_VALUES,
+          &init_options,
           &rclc_cppb::_allocator
-        )
-      )
+        );
+      // The support keeps its own copy of the options
+      rclc_cppb::error::handled_call<
+        decltype(&rcl_init_options_fini),
+        &rcl_init_options_fini
+      >(
+        &init_options
+      );
+      if(!success)
       {
         rclc_cppb::error::handled_call<
           decltype(&rclc_support_fini),
@@ -205,7 +751,7 @@ namespace rclc_cppb
         );
       }
       rclc_cppb::_executor = rclc_executor_get_zero_initialized_executor();
-      
+
       if(
         !rclc_cppb::error::handled_call<
           decltype(&rclc_executor_init),
@@ -213,8 +759,9 @@ namespace rclc_cppb
         >(
           &rclc_cppb::_executor,
           &rclc_cppb::_support.context,
-          Node::get_num_handles(),
-          &rclc_cppb::_allocator
+          // Sized by the entity graph when static, so that the storage is known at compile time
+          rclc_cppb::_has_executor_allocator ? rclc_cppb::_static_num_handles : Node::get_num_handles(),
+          rclc_cppb::_has_executor_allocator ? &rclc_cppb::_executor_allocator : &rclc_cppb::_allocator
         )
       )
       {
@@ -228,14 +775,27 @@ namespace rclc_cppb
   
   unsigned int Node::get_num_handles() noexcept
   {
-    return _num_handles;
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    unsigned int num_handles = 0;
+    for(const Node* node = Node::_first; node != NULL; node = node->_next)
+    {
+      #ifdef RCLC_CPPB_THREADS
+        // Added to the executor of the node instead
+        if(node->_is_threaded)
+        {
+          continue;
+        }
+      #endif
+      num_handles += node->_num_node_handles;
+    }
+    return num_handles;
   }
   void Node::add_handle() noexcept
   {
-    _num_handles++;
+    this->add_handles(1);
   }
   void Node::add_handles(unsigned int count) noexcept
   {
-    _num_handles += count;
+    this->_num_node_handles += count;
   }
 }
\ No newline at end of file
@@ -7,6 +7,9 @@
 
 #include <Arduino.h>
 
+#include "threading.hpp"
+#include "error.hpp"
+
 /**
  * C++ OOP bindings for Arduino microROS rclc.
  * This library does not contain all features of rcl.
@@ -33,11 +36,40 @@
  * suspend your program in an infinite loop in the ERROR_LOOP macro.
  * If macros are undefined, the methods will simply return false, and the program will continue
  * whenever a runtime error occurs.
+ * With RCLC_CPPB_COMPACT_ERRORS defined, register the failure action with @see{error::set_failure_hook} instead.
  * 
- * This library is NOT threadsafe.
+ * This library is NOT threadsafe, except on host builds where nodes may spin on their own threads,
+ * see @see{Node::set_threaded}.
 */
 namespace rclc_cppb
 {
+  /**
+   * Statistics of event-driven spinning, see @see{Node::spin_when_ready}
+  */
+  struct SpinStats
+  {
+    /**
+     * Total time in microseconds spent waiting for readiness
+    */
+    uint64_t idle_us;
+    /**
+     * Total time in microseconds spent spinning the executor
+    */
+    uint64_t busy_us;
+    /**
+     * Amount of spins woken by readiness rather than by timeout
+    */
+    uint32_t wake_count;
+    /**
+     * Time in microseconds from the last wake until its callbacks were dispatched
+    */
+    unsigned long last_wake_latency_us;
+    /**
+     * Largest time in microseconds from a wake until its callbacks were dispatched
+    */
+    unsigned long max_wake_latency_us;
+  };
+
   /**
    * ROS2 node designed to be used similarily to the Node class in rclcpp.
    * It is recommended to extend this class with your own custom node, but not mandatory.
@@ -52,10 +84,31 @@ namespace rclc_cppb
   */
   class Node
   {
-    private:
+    public:
       /**
-       * Default timeout for spinning in nanoseconds
+       * Function-pointer type of readiness check, returning true when the transport has data to read
       */
+      using ReadyCallback = bool(*)(void);
+
+      /**
+       * Timeout which makes spinning derive its timeout adaptively, see @see{get_adaptive_timeout_ns}
+      */
+      static constexpr uint64_t ADAPTIVE_SPIN_TIMEOUT = UINT64_MAX;
+      /**
+       * Default loop budget in nanoseconds, see @see{set_loop_budget_ns}
+      */
+      static constexpr uint64_t DEFAULT_LOOP_BUDGET_NS = RCL_MS_TO_NS(100);
+      #ifdef RCLC_CPPB_THREADS
+        /**
+         * Default poll period of threaded nodes in nanoseconds, see @see{set_threaded}
+        */
+        static constexpr uint64_t DEFAULT_THREAD_POLL_PERIOD_NS = RCL_MS_TO_NS(1);
+      #endif
+      /**
+       * Former default timeout of @see{spin_once} in nanoseconds, which now defaults to @see{ADAPTIVE_SPIN_TIMEOUT}.
+       * Pass it explicitly to keep the fixed timeout.
+      */
+      [[deprecated("spin_once() defaults to ADAPTIVE_SPIN_TIMEOUT, pass RCL_MS_TO_NS(100) for the fixed timeout")]]
       static constexpr uint64_t DEFAULT_SPIN_TIMEOUT_NS = RCL_MS_TO_NS(100);
 
     public:
@@ -68,6 +121,14 @@ namespace rclc_cppb
       */
       const char* const node_namespace;
     private:
+      /**
+       * First node in the list of all nodes
+      */
+      static Node* _first;
+      /**
+       * Next node in the list of all nodes
+      */
+      Node* _next;
       /**
        * rclc node struct
       */
@@ -76,6 +137,40 @@ namespace rclc_cppb
        * true if node initialization is done
       */
       bool _is_node_init = false;
+      /**
+       * true if the node was lost along with the session, and is to be set up again
+      */
+      bool _is_lost = false;
+      /**
+       * Amount of executor handles needed by the entities of this node
+      */
+      unsigned int _num_node_handles = 0;
+      #ifdef RCLC_CPPB_THREADS
+        /**
+         * true if this node has its own executor, spun on its own thread
+        */
+        bool _is_threaded = false;
+        /**
+         * true if the executor of this node is initialized
+        */
+        bool _is_executor_init = false;
+        /**
+         * Time in nanoseconds the thread waits between two spins, unless woken by @see{notify}
+        */
+        uint64_t _thread_poll_period_ns = Node::DEFAULT_THREAD_POLL_PERIOD_NS;
+        /**
+         * Executor of this node, used instead of the shared executor if threaded
+        */
+        rclc_executor_t _executor;
+        /**
+         * true while the thread should keep spinning
+        */
+        std::atomic<bool> _is_thread_running{false};
+        /**
+         * Thread spinning the executor of this node
+        */
+        std::thread _thread;
+      #endif
 
     public:
       /**
@@ -94,7 +189,7 @@ namespace rclc_cppb
       */
       Node(const char *node_name, const char *node_namespace = "") noexcept;
       /**
-       * First calls @see{on_kill}, then safely destroys rclc entities.
+       * First calls @see{on_kill}, then safely destroys rclc entities, and removes the node from the list of all nodes.
        * To add your own destructor behaviour, override @see{on_kill}.
       */
       ~Node() noexcept;
@@ -108,6 +203,38 @@ namespace rclc_cppb
        * @return true if success
       */
       bool setup(void) noexcept;
+      #ifdef RCLC_CPPB_THREADS
+        /**
+         * Gives this node its own executor, which is spun on a dedicated thread once @see{setup} succeeds.
+         * Other nodes, and the shared executor spun by @see{spin_once}, are not affected.
+         * Only available on host builds, and requires an rmw whose entities may be used from several threads.
+         *
+         * The XRCE session is shared, so spins of the thread take turns with @see{spin_once} and publishes under one lock.
+         * The thread only holds it to spin without waiting, then waits outside of it for poll_period_ns,
+         * or less if woken by @see{notify} or a triggered guard condition.
+         * Messages from the agent are therefore dispatched up to poll_period_ns late.
+         *
+         * This moves callbacks off the main loop, but does not spread them over cores:
+         * callbacks run within the spin, under the lock, so those of different nodes still run one at a time.
+         *
+         * Usage instructions:
+         * - Call before any node is setup, as the shared executor is sized without the handles of this node.
+         * - Set up the subscribers, services and guard conditions of the node in @see{on_setup},
+         *   since the thread starts spinning right after.
+         * - Their callbacks then run on the thread of this node.
+         * @param poll_period_ns Time in nanoseconds the thread waits between two spins
+        */
+        void set_threaded(uint64_t poll_period_ns = Node::DEFAULT_THREAD_POLL_PERIOD_NS) noexcept;
+        /**
+         * Stops the thread of this node, waiting for its current spin to finish.
+         * Called on destruction.
+        */
+        void stop_thread(void) noexcept;
+        /**
+         * Returns true if this node has its own executor, see @see{set_threaded}
+        */
+        bool is_threaded(void) const noexcept;
+      #endif
       /**
        * Virtual loop method to be called every loop-cycle of your program.
        * Does nothing unless overrided.
@@ -138,10 +265,112 @@ namespace rclc_cppb
       
       /**
        * Spins the node once, similar to spinOnce in rclcpp.
-       * @param timeout_ns Timeout in nanoseconds
+       * Runs all spin hooks afterwards, see @see{SpinHook}.
+       * On host builds the shared executor is spun by one thread at a time,
+       * and a spin without timeout is skipped while another thread is spinning.
+       * @param timeout_ns Timeout in nanoseconds, derived by @see{get_adaptive_timeout_ns} by default
+       * @return true if successful
+      */
+      static bool spin_once(uint64_t timeout_ns = Node::ADAPTIVE_SPIN_TIMEOUT) noexcept;
+      /**
+       * Waits until the transport is ready or a notification arrives, then spins the node once without waiting.
+       * The processor idles in between instead of polling the transport: with @code{wfi} on ARM,
+       * in poll on Linux, and elsewhere by sleeping with @code{delay} a millisecond at a time,
+       * which only saves power where the core runs an RTOS, e.g. on the ESP32.
+       * Readiness is given by the ready callback, checked at least every millisecond, and on Linux by the ready file descriptor.
+       * Without either, this behaves like @see{spin_once}.
+       * Timing is recorded in the spin statistics, see @see{get_spin_stats}.
+       * @param timeout_ns Maximum time to wait in nanoseconds, derived by @see{get_adaptive_timeout_ns} by default
        * @return true if successful
       */
-      static bool spin_once(uint64_t timeout_ns = Node::DEFAULT_SPIN_TIMEOUT_NS) noexcept;
+      static bool spin_when_ready(uint64_t timeout_ns = Node::ADAPTIVE_SPIN_TIMEOUT) noexcept;
+      /**
+       * Makes the executor allocate from the given allocator instead of the default heap allocator,
+       * and sizes it for a fixed amount of handles instead of the amount counted on setup.
+       * Called by @see{EntityGraph::use}. Call before any node is setup.
+       * @param allocator Allocator for the executor, whose state must outlive it
+       * @param handle_count Amount of executor handles the allocator is sized for
+      */
+      static void use_static_executor(rcl_allocator_t allocator, unsigned int handle_count) noexcept;
+      /**
+       * Sets the client key which identifies this client to the agent, used by every session created from then on.
+       * The agent recognises a client coming back with the same key, and replaces its entities
+       * instead of keeping the stale ones of the previous session around.
+       * Entities are still created anew on every session, as rmw does not expose the reuse creation mode.
+       * Store the key given by @see{get_client_key} where it survives a soft reset, e.g. in backup RAM,
+       * then set it again before any node is setup.
+       * By default the key is derived from the unique id of the device, where there is one (STM32, Linux host id).
+       * Boards without one, and several clients on one Linux host, must set a key unique among all clients of the agent,
+       * or each session gets a random key.
+       * @param key Client key, or 0 to derive one on the next session
+      */
+      static void set_client_key(uint32_t key) noexcept;
+      /**
+       * Retrieves the client key used by the current session, which is kept for all following sessions.
+       * @return Client key, or 0 if none was set and none could be derived from the device
+      */
+      static uint32_t get_client_key(void) noexcept;
+      /**
+       * Sets the loop budget, which is the intended period of the loop spinning the node.
+       * An adaptive spin waits no longer than what is left of the budget since the previous adaptive spin,
+       * so that the loop keeps its period regardless of how long the rest of it takes.
+       * @param budget_ns Loop budget in nanoseconds
+      */
+      static void set_loop_budget_ns(uint64_t budget_ns) noexcept;
+      /**
+       * Derives the timeout of an adaptive spin: what is left of the loop budget,
+       * or the time until the earliest spin hook is due if sooner, see @see{SpinHook::get_time_until_due_ns}.
+       * @return Timeout in nanoseconds, zero if work is due already
+      */
+      static uint64_t get_adaptive_timeout_ns(void) noexcept;
+      /**
+       * Sets the readiness check used by @see{spin_when_ready}, e.g. one returning @code{Serial.available() > 0}.
+       * @param callback Pointer to readiness check, or NULL to remove it
+      */
+      static void set_ready_callback(ReadyCallback callback) noexcept;
+      #if defined(__linux__)
+        /**
+         * Sets the file descriptor of the transport, which @see{spin_when_ready} sleeps on with poll.
+         * @param fd File descriptor, or -1 to remove it
+        */
+        static void set_ready_fd(int fd) noexcept;
+      #endif
+      /**
+       * Wakes @see{spin_when_ready} and the threads of threaded nodes, so that the next spin takes place immediately.
+       * Safe to call from an interrupt service routine, and on Linux from another thread, as it also writes an eventfd
+       * that the poll waits on.
+      */
+      static void notify(void) noexcept;
+      /**
+       * Retrieves the statistics of event-driven spinning
+       * @return Reference to spin statistics
+      */
+      static const SpinStats& get_spin_stats(void) noexcept;
+      /**
+       * Resets the statistics of event-driven spinning to zero
+      */
+      static void reset_spin_stats(void) noexcept;
+      /**
+       * Retrieves the failure counters of the first rcl function which has failed,
+       * the others following through @see{error::CallSite::get_next}
+       * @return Pointer to call site, or NULL if nothing has failed
+      */
+      static const error::CallSite* get_failed_calls(void) noexcept;
+      /**
+       * Retrieves the amount of failed rcl calls, timeouts of spins excluded
+      */
+      static uint32_t get_failure_count(void) noexcept;
+      /**
+       * Retrieves one of the latest failed rcl calls, failures in a row of the same function and return code merged
+       * @param index Index of the failure, 0 being the latest
+       * @param failure Pointer to where the failure is written
+       * @return true if there is a failure at given index
+      */
+      static bool get_recent_failure(size_t index, error::Failure* failure) noexcept;
+      /**
+       * Resets the failure counters of all rcl functions, and forgets the recent failures
+      */
+      static void reset_failures(void) noexcept;
     protected:
       /**
        * Called after the node has been successfully set up, see @see{setup}.
@@ -162,18 +391,45 @@ namespace rclc_cppb
       */
       static bool init(void) noexcept;
       /**
-       * Returns the number of handles needed for executor to manage.
+       * Returns true if the session to the agent is up, i.e. rclc and the shared executor are initialized
+      */
+      static bool is_session_up(void) noexcept;
+      /**
+       * Finalizes all entities, nodes, executors and the rclc support after the session to the agent was lost,
+       * without waiting for the agent, and stops the threads of threaded nodes.
+       * Called by @see{ReconnectSupervisor}.
+      */
+      static void teardown_session(void) noexcept;
+      /**
+       * Sets up all nodes which were lost along with the session, calling their @see{on_setup} again,
+       * then creates every lost entity again that was not created by it.
+       * Called by @see{ReconnectSupervisor}, and may be retried until it succeeds.
+       * @return true if success
+      */
+      static bool restore_session(void) noexcept;
+      /**
+       * Returns the number of handles needed for the shared executor to manage, which excludes those of threaded nodes.
       */
       static unsigned int get_num_handles() noexcept;
       /**
-       * Adds an executor handle.
+       * Adds an executor handle, owned by this node.
       */
-      static void add_handle() noexcept;
+      void add_handle() noexcept;
       /**
-       * Adds a given amount of executor handles.
+       * Adds a given amount of executor handles, owned by this node.
        * @param count Amount of handles to add
       */
-      static void add_handles(unsigned int count) noexcept;
+      void add_handles(unsigned int count) noexcept;
+      /**
+       * Returns true if the transport is ready or a notification has arrived
+      */
+      static bool is_ready(void) noexcept;
+      /**
+       * Idles the processor until an interrupt, or on Linux until the ready file descriptor or a notification is readable,
+       * otherwise for a millisecond at most
+       * @param timeout_us Maximum time to idle in microseconds
+      */
+      static void idle(unsigned long timeout_us) noexcept;
       
       /**
        * Retrieves pointer to rcl node entity
@@ -191,7 +447,17 @@ namespace rclc_cppb
        * Retrieves mutable pointer to rcl executor entity
       */
       static rclc_executor_t* get_executor_mut(void) noexcept;
+      /**
+       * Retrieves mutable pointer to the rcl executor entity the handles of this node are added to,
+       * which is its own executor if threaded, otherwise the shared one
+      */
+      rclc_executor_t* get_node_executor_mut(void) noexcept;
+      /**
+       * Retrieves mutable pointer to rcl context entity
+      */
+      static rcl_context_t* get_context_mut(void) noexcept;
 
       friend class Handle;
+      friend class ReconnectSupervisor;
   };
 }
\ No newline at end of file
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <micro_ros_arduino.h>
+#include <rcl/rcl.h>
+#include <rcl/error_handling.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+
+#include "message.hpp"
+#include "serialization.hpp"
+#include "node.hpp"
+#include "subscriber.hpp"
+#include "mpsc_queue.hpp"
+#include "callback_pool.hpp"
+
+#ifdef RCLC_CPPB_THREADS
+
+namespace rclc_cppb
+{
+  /**
+   * Order in which a @see{PooledSubscriber} runs its callbacks
+  */
+  enum class Ordering: uint8_t
+  {
+    /**
+     * Callbacks run concurrently, in any order
+    */
+    UNORDERED = 0,
+    /**
+     * Callbacks run one at a time, in the order the messages were received
+    */
+    ORDERED = 1
+  };
+  /**
+   * What a @see{PooledSubscriber} does with a message when it cannot keep up.
+   * The executor never waits for the pool, as it holds the spin lock that publishing from a callback needs.
+  */
+  enum class Backpressure: uint8_t
+  {
+    /**
+     * The message is dropped and counted
+    */
+    DROP = 0,
+    /**
+     * The callback runs within the executor instead, which slows down receiving.
+     * Ordered subscribers cannot do so while their callbacks are running without breaking the order,
+     * so once all of their slots are taken they drop and count the message as well.
+    */
+    RUN_IN_EXECUTOR = 1,
+    /**
+     * Former name of RUN_IN_EXECUTOR, from when the executor waited for the pool
+    */
+    BLOCK [[deprecated("the executor no longer waits for the pool, use RUN_IN_EXECUTOR")]] = RUN_IN_EXECUTOR
+  };
+
+  /**
+   * Subscriber whose callback runs on a @see{CallbackPool} instead of within the executor, only available on host builds.
+   *
+   * Each received message is copied into one of a fixed amount of slots, and the callback is queued on the pool,
+   * so that a CPU-heavy callback does not hold up the rest of the executor.
+   * A slot is free again once its callback returns.
+   * When no slot is free, or the pool rejects the callback, the backpressure policy applies.
+   * The executor never waits for a slot or for the pool, so callbacks may publish, call services or trigger guard conditions.
+   *
+   * Messages are copied by value, so the message type must be fixed-size according to its Reflection trait,
+   * which rules out sequences whose memory would be overwritten by the next message.
+   *
+   * Usage instructions:
+   * - Instantiate before any node is setup.
+   * - Call subscribe() in on_setup-method of node or after node setup is completed.
+   * - The callback runs on a worker of the pool, so it must guard whatever it shares.
+   * @param <_MessageType> Message type handled by subscriber
+   * @param <SLOT_COUNT> Maximum amount of messages waiting for or running their callback, which must be a power of two
+  */
+  template<typename _MessageType, size_t SLOT_COUNT>
+  class PooledSubscriber
+  {
+    static_assert(Reflect<_MessageType>::IS_FIXED_SIZE, "Message type must be fixed-size, with trait Reflection implemented!");
+
+    public:
+      /**
+       * Message type handled by subscriber
+      */
+      using MessageType = _MessageType;
+      /**
+       * Function-pointer type of callback function used by this subscriber
+      */
+      using CallbackType = typename Subscriber<MessageType>::CallbackType;
+
+      /**
+       * Amount of executor handles needed by this subscriber
+      */
+      static constexpr unsigned int HANDLE_COUNT = Subscriber<MessageType>::HANDLE_COUNT;
+    private:
+      /**
+       * Copy of a received message, waiting for or running its callback
+      */
+      struct Slot
+      {
+        /**
+         * Copy of message
+        */
+        MessageType message;
+        /**
+         * Subscriber owning the slot
+        */
+        PooledSubscriber* owner;
+      };
+
+      /**
+       * Subscriber receiving the messages within the executor
+      */
+      Subscriber<MessageType> _subscriber;
+      /**
+       * Pool running the callbacks
+      */
+      CallbackPool* const _pool;
+      /**
+       * Callback function used by this subscriber
+      */
+      const CallbackType _callback;
+      /**
+       * Order in which callbacks run
+      */
+      const Ordering _ordering;
+      /**
+       * What happens to messages when no slot is free or the pool is saturated
+      */
+      const Backpressure _backpressure;
+      /**
+       * Slots
+      */
+      Slot _slots[SLOT_COUNT];
+      /**
+       * Indices of free slots, released by workers and taken by the executor
+      */
+      MpscQueue<size_t, SLOT_COUNT> _free_slots;
+      /**
+       * Indices of slots waiting for their callback when ordered, in order of reception
+      */
+      MpscQueue<size_t, SLOT_COUNT> _ordered_slots;
+      /**
+       * Amount of ordered slots waiting for or running their callback.
+       * The message raising it from zero queues the task draining them, which runs until it is back at zero.
+      */
+      std::atomic<size_t> _ordered_count;
+      /**
+       * Amount of messages dropped
+      */
+      std::atomic<uint32_t> _dropped_count;
+
+    public:
+      /**
+       * Subscriber whose callback runs on a @see{CallbackPool} instead of within the executor.
+       * @param <_MessageType> Message type handled by subscriber
+       * @param <SLOT_COUNT> Maximum amount of messages waiting for or running their callback
+       * @param node Pointer to node owning the subscriber
+       * @param topic_name Topic name (slash and namespace of node is appended later)
+       * @param callback Pointer to callback-function run on the pool
+       * @param pool Pool running the callbacks
+       * @param ordering Order in which callbacks run
+       * @param backpressure What happens to messages when no slot is free or the pool is saturated
+      */
+      PooledSubscriber(
+        Node* node,
+        const char* topic_name,
+        CallbackType callback,
+        CallbackPool* pool,
+        Ordering ordering = Ordering::ORDERED,
+        Backpressure backpressure = Backpressure::RUN_IN_EXECUTOR
+      ) noexcept;
+
+      /**
+       * Initializes the subscriber, and then subscribes to the topic on the ROS2 network.
+       * Node must be successfully initialized for this to succeed.
+       * @return true if success
+      */
+      bool subscribe(rclc_executor_handle_invocation_t invocation = ON_NEW_DATA) noexcept;
+
+      /**
+       * Sets the priority class of the subscriber, see @see{Handle::set_priority}
+       * @param priority Priority class
+      */
+      void set_priority(Priority priority) noexcept;
+
+      /**
+       * Retrieves the amount of messages dropped because of backpressure
+       * @return Amount of messages
+      */
+      uint32_t get_dropped_count(void) const noexcept;
+    private:
+      /**
+       * Copies a received message into a free slot and hands it to the pool. Runs within the executor.
+       * @param message Received message
+       * @param context Pointer to the pooled subscriber
+      */
+      static void on_message(const MessageType* message, void* context) noexcept;
+      /**
+       * Runs the callback of one slot, then frees it. Runs on the pool.
+       * @param context Pointer to the slot
+      */
+      static void run_slot(void* context) noexcept;
+      /**
+       * Runs the callbacks of the ordered slots in order, until none are left. Runs on the pool.
+       * @param context Pointer to the pooled subscriber
+      */
+      static void run_ordered(void* context) noexcept;
+      /**
+       * Applies the backpressure policy to a message which could not be handed off to the pool. Runs within the executor.
+       * @param message Received message
+      */
+      void on_overload(const MessageType* message) noexcept;
+  };
+}
+
+#include "pooled_subscriber_impl.hpp"
+
+#endif
\ No newline at end of file
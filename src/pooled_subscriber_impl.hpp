@@ -0,0 +1,125 @@
+#pragma once
+
+#include "pooled_subscriber.hpp"
+
+namespace rclc_cppb
+{
+  template<typename _MessageType, size_t SLOT_COUNT>
+  PooledSubscriber<_MessageType, SLOT_COUNT>::PooledSubscriber(
+    Node* node,
+    const char* topic_name,
+    CallbackType callback,
+    CallbackPool* pool,
+    Ordering ordering,
+    Backpressure backpressure
+  ) noexcept:
+    _subscriber(node, topic_name, &PooledSubscriber::on_message, this),
+    _pool(pool),
+    _callback(callback),
+    _ordering(ordering),
+    _backpressure(backpressure),
+    _ordered_count(0),
+    _dropped_count(0)
+  {
+    for(size_t i = 0; i < SLOT_COUNT; i++)
+    {
+      this->_slots[i].owner = this;
+      this->_free_slots.push(i);
+    }
+  }
+
+  template<typename _MessageType, size_t SLOT_COUNT>
+  bool PooledSubscriber<_MessageType, SLOT_COUNT>::subscribe(
+    rclc_executor_handle_invocation_t invocation
+  ) noexcept
+  {
+    return this->_subscriber.subscribe(invocation);
+  }
+
+  template<typename _MessageType, size_t SLOT_COUNT>
+  void PooledSubscriber<_MessageType, SLOT_COUNT>::set_priority(Priority priority) noexcept
+  {
+    this->_subscriber.set_priority(priority);
+  }
+
+  template<typename _MessageType, size_t SLOT_COUNT>
+  uint32_t PooledSubscriber<_MessageType, SLOT_COUNT>::get_dropped_count(void) const noexcept
+  {
+    return this->_dropped_count;
+  }
+
+  template<typename _MessageType, size_t SLOT_COUNT>
+  void PooledSubscriber<_MessageType, SLOT_COUNT>::on_message(
+    const MessageType* message,
+    void* context
+  ) noexcept
+  {
+    PooledSubscriber* subscriber = (PooledSubscriber*)context;
+
+    size_t index;
+    if(!subscriber->_free_slots.pop(index))
+    {
+      subscriber->on_overload(message);
+      return;
+    }
+    Slot& slot = subscriber->_slots[index];
+    slot.message = *message;
+
+    if(subscriber->_ordering == Ordering::UNORDERED)
+    {
+      if(!subscriber->_pool->submit(&PooledSubscriber::run_slot, &slot))
+      {
+        subscriber->_free_slots.push(index);
+        subscriber->on_overload(message);
+      }
+      return;
+    }
+
+    // Never full, as only slots taken from the free slots are queued
+    subscriber->_ordered_slots.push(index);
+    if(
+      subscriber->_ordered_count.fetch_add(1) == 0 &&
+      !subscriber->_pool->submit(&PooledSubscriber::run_ordered, subscriber)
+    )
+    {
+      // No callback of this subscriber is running, so the executor keeps the order when it drains the slots itself
+      PooledSubscriber::run_ordered(subscriber);
+    }
+  }
+
+  template<typename _MessageType, size_t SLOT_COUNT>
+  void PooledSubscriber<_MessageType, SLOT_COUNT>::run_slot(void* context) noexcept
+  {
+    Slot* slot = (Slot*)context;
+    PooledSubscriber* subscriber = slot->owner;
+    subscriber->_callback(&slot->message);
+    subscriber->_free_slots.push((size_t)(slot - subscriber->_slots));
+  }
+
+  template<typename _MessageType, size_t SLOT_COUNT>
+  void PooledSubscriber<_MessageType, SLOT_COUNT>::run_ordered(void* context) noexcept
+  {
+    PooledSubscriber* subscriber = (PooledSubscriber*)context;
+    do
+    {
+      // Pushed before being counted, so it is there to pop
+      size_t index;
+      subscriber->_ordered_slots.pop(index);
+      subscriber->_callback(&subscriber->_slots[index].message);
+      subscriber->_free_slots.push(index);
+    }
+    while(subscriber->_ordered_count.fetch_sub(1) != 1);
+  }
+
+  template<typename _MessageType, size_t SLOT_COUNT>
+  void PooledSubscriber<_MessageType, SLOT_COUNT>::on_overload(const MessageType* message) noexcept
+  {
+    // Waiting here instead would deadlock with a callback publishing, as the executor holds the spin lock
+    if(this->_backpressure == Backpressure::RUN_IN_EXECUTOR && this->_ordering == Ordering::UNORDERED)
+    {
+      this->_callback(message);
+      return;
+    }
+    this->_dropped_count++;
+  }
+}
\ No newline at end of file
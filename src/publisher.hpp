@@ -7,8 +7,14 @@
 #include <rclc/executor.h>
 
 #include "message.hpp"
+#include "reflection.hpp"
+#include "serialization.hpp"
 #include "node.hpp"
 #include "handle.hpp"
+#include "local_subscription.hpp"
+#include "topic_statistics.hpp"
+#include "latency_probe.hpp"
+#include "threading.hpp"
 
 namespace rclc_cppb
 {
@@ -21,6 +27,8 @@ namespace rclc_cppb
    * - Instantiate before any node is setup.
    * - Call advertise() in on_setup-method of node or after node setup is completed.
    * - Message type must have Message trait implemented on it.
+   * - On host builds, setting data and publishing are safe from several threads.
+   * - Local subscribers on the same device which called subscribe_local() receive messages directly, see @see{LocalSubscriber}.
    * @param <_MessageType> Message type handled by publisher
   */
   template<typename _MessageType>
@@ -41,6 +49,11 @@ namespace rclc_cppb
        * Reference to internal data type of message
       */
       using DataRef = typename Message<MessageType>::DataRef;
+
+      /**
+       * Amount of executor handles needed by this publisher
+      */
+      static constexpr unsigned int HANDLE_COUNT = 0;
     public:
       /**
        * Topic name
@@ -48,9 +61,9 @@ namespace rclc_cppb
       const char* const topic_name;
     private:
       /**
-       * Message
+       * Message, mutable as publishing stamps its header when probing latency
       */
-      MessageType _message;
+      mutable MessageType _message;
       /**
        * rclc publisher entity
       */
@@ -58,7 +71,31 @@ namespace rclc_cppb
       /**
        * true if publisher has been successfully initialized
       */
-      bool _init_done;
+      bool _init_done = false;
+      /**
+       * true if the current message data has been published successfully, so that publishing it again can be skipped.
+       * Mutable, as publishing updates it.
+      */
+      mutable bool _is_data_published = false;
+      /**
+       * true if messages are only delivered to subscribers on the same device
+      */
+      bool _is_local_only = false;
+      /**
+       * Statistics recorded for each published message, or NULL if untracked
+      */
+      TopicStatistics* _statistics = NULL;
+      /**
+       * true if the header of each message is stamped with the synchronized epoch clock on publish,
+       * even if auto-stamping is disabled
+      */
+      bool _is_probing_latency = false;
+      /**
+       * Guards the message against being set and published from several threads at once.
+       * Recursive, as a local subscriber may publish again from within the publish call.
+       * Publishing takes the spin mutex before this one, as the XRCE session is shared.
+      */
+      mutable threading::RecursiveMutex _mutex;
     public:
       /**
        * ROS2 publisher designed to be similar to the Publisher class in rclcpp.
@@ -86,6 +123,25 @@ namespace rclc_cppb
        * @return true if success
       */
       bool advertise() noexcept;
+      /**
+       * Sets whether messages are only delivered to subscribers on the same device, skipping the agent entirely.
+       * A local-only publisher needs not be advertised.
+       * @param is_local_only true to deliver only locally
+      */
+      void set_local_only(bool is_local_only) noexcept;
+      /**
+       * Tracks statistics of the published messages, see @see{TopicStatistics}
+       * @param statistics Pointer to statistics, or NULL to stop tracking
+      */
+      void set_statistics(TopicStatistics* statistics) noexcept;
+      /**
+       * Sets whether the header of each message is stamped on publish with the epoch clock synchronized with the agent,
+       * so that subscribers can probe the one-way latency, see @see{Subscriber::set_latency_probe}.
+       * Stamped regardless of @see{Clock::set_auto_stamp}, but not until the clock is synchronized, see @see{Clock}.
+       * The message type must carry a std_msgs/Header.
+       * @param is_probing true to stamp messages
+      */
+      void set_latency_probe(bool is_probing) noexcept;
       
       /**
        * Sets message data.
@@ -93,24 +149,59 @@ namespace rclc_cppb
       */
       void set_data(DataType data) noexcept;
       /**
-       * Retrieves last sent message data as reference
+       * Retrieves last sent message data as reference.
+       * Not guarded against other threads publishing meanwhile.
        * @return Reference to message data
       */
       DataRef get_last_data(void) noexcept;
 
       /**
        * Publishes current message onto topic.
-       * Publisher must be successfully advertised for this to succeed.
+       * Local subscribers receive it first, then it is published through the agent unless local-only.
+       * Message types with the FixedLayout trait implemented are serialized with a single memcpy.
+       * Publisher must be successfully advertised for this to succeed, unless local-only.
        * @return true if success
       */
       bool publish(void) const noexcept;
       /**
        * Publishes message with given data onto topic.
-       * Publisher must be successfully advertised for this to succeed.
+       * Publisher must be successfully advertised for this to succeed, unless local-only.
        * @param data Message data
        * @return true if success
       */
       bool publish(DataType data) noexcept;
+      /**
+       * Publishes message with given data onto topic, unless the data equals the last data published successfully.
+       * Data which failed to publish, was only set, or equals the initial data but was never published, is published again.
+       * Comparison is derived from the Reflection trait, which must be implemented for the data type.
+       * Publisher must be successfully advertised for this to succeed, unless local-only.
+       * @param data Message data
+       * @return true if success, or if the data was unchanged
+      */
+      bool publish_if_changed(DataType data) noexcept;
+    private:
+      /**
+       * Delivers current message to local subscribers, then publishes it onto topic without spinning,
+       * with the message already guarded by the caller.
+       * @return true if success
+      */
+      bool publish_message(void) const noexcept;
+      /**
+       * Body of @see{publish_message}, leaving the published flag to it
+       * @return true if success
+      */
+      bool publish_current_message(void) const noexcept;
+    protected:
+      /**
+       * Finalizes the publisher after the session to the agent was lost
+       * @return true if it had been advertised
+      */
+      bool on_session_lost(void) noexcept override;
+      /**
+       * Advertises the publisher again after the session to the agent was restored
+       * @return true if success
+      */
+      bool on_session_restored(void) noexcept override;
   };
 };
 
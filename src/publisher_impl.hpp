@@ -3,6 +3,7 @@
 #include "publisher.hpp"
 
 #include "error.hpp"
+#include "trace.hpp"
 
 //https://micro.ros.org/docs/tutorials/programming_rcl_rclc/pub_sub/
 
@@ -14,7 +15,7 @@ namespace rclc_cppb
     const char* const topic_name,
     const typename Publisher<MessageType>::DataType default_data
   ) noexcept:
-    Handle(node),
+    Handle(node, Publisher::HANDLE_COUNT),
     topic_name(topic_name),
     _message(Message<MessageType>::from_data(default_data))
   {
@@ -65,15 +66,44 @@ namespace rclc_cppb
       }
       this->_init_done = true;
       
-      Node::spin_once();
+      Node::spin_once(0);
     }
     return true;
   }
 
+  template<typename _MessageType>
+  void Publisher<_MessageType>::set_local_only(bool is_local_only) noexcept
+  {
+    threading::RecursiveLock lock(this->_mutex);
+    this->_is_local_only = is_local_only;
+  }
+
+  template<typename _MessageType>
+  void Publisher<_MessageType>::set_statistics(TopicStatistics* statistics) noexcept
+  {
+    threading::RecursiveLock lock(this->_mutex);
+    if(statistics != NULL)
+    {
+      statistics->attach(this->topic_name);
+    }
+    this->_statistics = statistics;
+  }
+
+  template<typename _MessageType>
+  void Publisher<_MessageType>::set_latency_probe(bool is_probing) noexcept
+  {
+    static_assert(latency::IsStamped<MessageType>::value, "Message type must carry a std_msgs/Header!");
+
+    threading::RecursiveLock lock(this->_mutex);
+    this->_is_probing_latency = is_probing;
+  }
+
   template<typename _MessageType>
   void Publisher<_MessageType>::set_data(DataType data) noexcept
   {
+    threading::RecursiveLock lock(this->_mutex);
     Message<MessageType>::set_data(this->_message, data);
+    this->_is_data_published = false;
   }
   template<typename _MessageType>
   typename Message<_MessageType>::DataRef
@@ -85,28 +115,160 @@ namespace rclc_cppb
   template<typename _MessageType>
   bool Publisher<_MessageType>::publish(void) const noexcept
   {
-    if(
-      !this->_init_done ||
-      !rclc_cppb::error::handled_call<
+    {
+      threading::RecursiveLock spin_lock(threading::get_spin_mutex());
+      threading::RecursiveLock lock(this->_mutex);
+      if(!this->publish_message())
+      {
+        return false;
+      }
+    }
+    // Outside of the lock, as callbacks run by the spin may publish again
+    Node::spin_once(0);
+    return true;
+  }
+
+  template<typename _MessageType>
+  bool Publisher<_MessageType>::publish_message(void) const noexcept
+  {
+    this->_is_data_published = this->publish_current_message();
+    return this->_is_data_published;
+  }
+
+  template<typename _MessageType>
+  bool Publisher<_MessageType>::publish_current_message(void) const noexcept
+  {
+    if constexpr(latency::IsStamped<MessageType>::value)
+    {
+      if((this->_is_probing_latency || Clock::is_auto_stamping()) && Clock::is_synced())
+      {
+        latency::set_stamp_ns(this->_message, Clock::now_ns());
+      }
+    }
+    LocalSubscription::deliver_all(
+      this->get_node()->node_namespace,
+      this->topic_name,
+      Message<MessageType>::get_type_support(),
+      &this->_message
+    );
+    if(this->_statistics != NULL)
+    {
+      this->_statistics->record(TopicStatistics::get_message_size(this->_message));
+    }
+    if(this->_is_local_only)
+    {
+      return true;
+    }
+
+    if constexpr(FixedLayout<MessageType>::IS_IMPL)
+    {
+      // Fast path, skipping the field by field serialization of the type-support
+      uint8_t buffer[FixedLayout<MessageType>::SERIALIZED_SIZE];
+      rcl_serialized_message_t serialized_message = {};
+      serialized_message.buffer = buffer;
+      serialized_message.buffer_capacity = sizeof(buffer);
+      serialized_message.buffer_length = rclc_cppb::serialization::serialize(
+        this->_message,
+        buffer,
+        sizeof(buffer)
+      );
+
+      RCLC_CPPB_TRACE(PUBLISH_BEGIN, this->topic_name, 0);
+      const bool success =
+        this->_init_done &&
+        rclc_cppb::error::handled_call<
+          decltype(&rcl_publish_serialized_message),
+          &rcl_publish_serialized_message
+        >(
+          &this->_publisher,
+          &serialized_message,
+          (rmw_publisher_allocation_t*)NULL
+        );
+      RCLC_CPPB_TRACE(PUBLISH_END, this->topic_name, success);
+      if(!success)
+      {
+        Handle::count_lost_message();
+      }
+      return success;
+    }
+
+    RCLC_CPPB_TRACE(PUBLISH_BEGIN, this->topic_name, 0);
+    const bool success =
+      this->_init_done &&
+      rclc_cppb::error::handled_call<
         decltype(&rcl_publish),
         &rcl_publish
       >(
         &this->_publisher,
         &this->_message,
         (rmw_publisher_allocation_t*)NULL
+      );
+    RCLC_CPPB_TRACE(PUBLISH_END, this->topic_name, success);
+    if(!success)
+    {
+      Handle::count_lost_message();
+    }
+    return success;
+  }
+
+  template<typename _MessageType>
+  bool Publisher<_MessageType>::publish(DataType data) noexcept
+  {
+    {
+      threading::RecursiveLock spin_lock(threading::get_spin_mutex());
+      threading::RecursiveLock lock(this->_mutex);
+      Message<MessageType>::set_data(this->_message, data);
+      if(!this->publish_message())
+      {
+        return false;
+      }
+    }
+    Node::spin_once(0);
+    return true;
+  }
+
+  template<typename _MessageType>
+  bool Publisher<_MessageType>::publish_if_changed(DataType data) noexcept
+  {
+    static_assert(Reflect<DataType>::IS_IMPL, "Trait Reflection must be implemented for message data!");
+
+    {
+      threading::RecursiveLock spin_lock(threading::get_spin_mutex());
+      threading::RecursiveLock lock(this->_mutex);
+      // The current message is the last one published successfully, unless the flag says otherwise
+      if(
+        this->_is_data_published &&
+        rclc_cppb::reflection::equals<DataType>(data, Message<MessageType>::get_data(this->_message))
       )
-    )
+      {
+        return true;
+      }
+      Message<MessageType>::set_data(this->_message, data);
+      if(!this->publish_message())
+      {
+        return false;
+      }
+    }
+    Node::spin_once(0);
+    return true;
+  }
+
+  template<typename _MessageType>
+  bool Publisher<_MessageType>::on_session_lost(void) noexcept
+  {
+    threading::RecursiveLock lock(this->_mutex);
+    if(!this->_init_done)
     {
       return false;
     }
-    Node::spin_once();
+    this->_init_done = false;
+    // Errors are expected, as the agent is gone
+    (void)rcl_publisher_fini(&this->_publisher, this->get_node_handle_mut());
     return true;
   }
-
   template<typename _MessageType>
-  bool Publisher<_MessageType>::publish(DataType data) noexcept
+  bool Publisher<_MessageType>::on_session_restored(void) noexcept
   {
-    this->set_data(data);
-    return this->publish();
+    return this->advertise();
   }
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <micro_ros_arduino.h>
+#include <rcl/rcl.h>
+#include <rcl/error_handling.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+
+#include <type_traits>
+
+#include "message.hpp"
+#include "node.hpp"
+#include "publisher.hpp"
+#include "spin_hook.hpp"
+#include "mpsc_queue.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Publisher which can be pushed to from interrupt service routines and other threads.
+   *
+   * Pushed message data is put on a lock-free queue, see @see{MpscQueue},
+   * which is drained into the publisher on every spin of the executor thread, see @see{SpinHook}.
+   * Pushing thus never publishes or spins, and never blocks.
+   *
+   * Usage instructions:
+   * - Instantiate before any node is setup.
+   * - Call advertise() in on_setup-method of node or after node setup is completed.
+   * - Call push() from anywhere, and spin the node as usual.
+   * - Message type must have Message trait implemented on it, with trivially copyable message data.
+   * @param <_MessageType> Message type handled by publisher
+   * @param <CAPACITY> Maximum amount of queued messages, which must be a power of two
+  */
+  template<typename _MessageType, size_t CAPACITY>
+  class QueuedPublisher: SpinHook
+  {
+    static_assert(Message<_MessageType>::IS_IMPL, "Trait Message must be implemented!");
+    static_assert(
+      std::is_trivially_copyable<typename Message<_MessageType>::DataType>::value,
+      "Message data must be trivially copyable!"
+    );
+
+    public:
+      /**
+       * Message type handled by publisher
+      */
+      using MessageType = _MessageType;
+      /**
+       * Internal data type of message
+      */
+      using DataType = typename Message<MessageType>::DataType;
+
+      /**
+       * Amount of executor handles needed by this publisher
+      */
+      static constexpr unsigned int HANDLE_COUNT = Publisher<MessageType>::HANDLE_COUNT;
+    private:
+      /**
+       * Publisher draining the queue
+      */
+      Publisher<MessageType> _publisher;
+      /**
+       * Queue of message data waiting to be published
+      */
+      MpscQueue<DataType, CAPACITY> _queue;
+      /**
+       * true if publisher has been successfully advertised
+      */
+      bool _is_advertised = false;
+      /**
+       * Amount of queued messages dropped because they failed to publish
+      */
+      uint32_t _dropped_count = 0;
+
+    public:
+      /**
+       * Publisher which can be pushed to from interrupt service routines and other threads.
+       *
+       * Usage instructions:
+       * - Instantiate before any node is setup.
+       * - Call advertise() in on_setup-method of node or after node setup is completed.
+       * - Call push() from anywhere, and spin the node as usual.
+       * @param <_MessageType> Message type handled by publisher
+       * @param <CAPACITY> Maximum amount of queued messages, which must be a power of two
+       * @param node Pointer to node owning the publisher
+       * @param topic_name Topic name (slash and namespace of node is appended later)
+       * @param default_data Initial message data
+      */
+      QueuedPublisher(
+        Node* node,
+        const char* topic_name,
+        DataType default_data
+      ) noexcept;
+
+      /**
+       * Initializes the publisher, and then advertises the topic onto the ROS2 network.
+       * Node must be successfully initialized for this to succeed.
+       * @return true if success
+      */
+      bool advertise(void) noexcept;
+
+      /**
+       * Queues message data to be published on the next spin, and wakes @see{Node::spin_when_ready}.
+       * Safe to call from interrupt service routines and any thread.
+       * @param data Message data
+       * @return false if the queue was full and the data was dropped
+      */
+      bool push(DataType data) noexcept;
+
+      /**
+       * Retrieves the amount of messages dropped because the queue was full
+       * @return Amount of messages
+      */
+      uint32_t get_overflow_count(void) const noexcept;
+      /**
+       * Retrieves the amount of queued messages dropped because they failed to publish
+       * @return Amount of messages
+      */
+      uint32_t get_dropped_count(void) const noexcept;
+    protected:
+      /**
+       * Drains the queue into the publisher
+      */
+      void on_spin(void) noexcept override;
+      /**
+       * Returns zero while messages are queued, so that adaptive spins do not wait
+      */
+      uint64_t get_time_until_due_ns(void) const noexcept override;
+  };
+}
+
+#include "queued_publisher_impl.hpp"
\ No newline at end of file
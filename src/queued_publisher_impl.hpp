@@ -0,0 +1,79 @@
+#pragma once
+
+#include "queued_publisher.hpp"
+
+namespace rclc_cppb
+{
+  template<typename _MessageType, size_t CAPACITY>
+  QueuedPublisher<_MessageType, CAPACITY>::QueuedPublisher(
+    Node* node,
+    const char* topic_name,
+    DataType default_data
+  ) noexcept:
+    _publisher(node, topic_name, default_data)
+  {
+
+  }
+
+  template<typename _MessageType, size_t CAPACITY>
+  bool QueuedPublisher<_MessageType, CAPACITY>::advertise(void) noexcept
+  {
+    if(!this->_publisher.advertise())
+    {
+      return false;
+    }
+    this->_is_advertised = true;
+    return true;
+  }
+
+  template<typename _MessageType, size_t CAPACITY>
+  bool QueuedPublisher<_MessageType, CAPACITY>::push(DataType data) noexcept
+  {
+    if(!this->_queue.push(data))
+    {
+      return false;
+    }
+    Node::notify();
+    return true;
+  }
+
+  template<typename _MessageType, size_t CAPACITY>
+  uint32_t QueuedPublisher<_MessageType, CAPACITY>::get_overflow_count(void) const noexcept
+  {
+    return this->_queue.get_overflow_count();
+  }
+  template<typename _MessageType, size_t CAPACITY>
+  uint32_t QueuedPublisher<_MessageType, CAPACITY>::get_dropped_count(void) const noexcept
+  {
+    return this->_dropped_count;
+  }
+
+  template<typename _MessageType, size_t CAPACITY>
+  void QueuedPublisher<_MessageType, CAPACITY>::on_spin(void) noexcept
+  {
+    // Messages stay queued until the publisher is up
+    if(!this->_is_advertised)
+    {
+      return;
+    }
+    // At most one queue-full per spin, so that producers pushing faster than publishing cannot stall the spin
+    DataType data;
+    for(size_t i = 0; i < CAPACITY && this->_queue.pop(data); i++)
+    {
+      if(!this->_publisher.publish(data))
+      {
+        this->_dropped_count++;
+      }
+    }
+  }
+
+  template<typename _MessageType, size_t CAPACITY>
+  uint64_t QueuedPublisher<_MessageType, CAPACITY>::get_time_until_due_ns(void) const noexcept
+  {
+    if(!this->_is_advertised || this->_queue.is_empty())
+    {
+      return SpinHook::NEVER_DUE;
+    }
+    return 0;
+  }
+}
\ No newline at end of file
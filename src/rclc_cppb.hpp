@@ -2,10 +2,37 @@
 
 #include "node.hpp"
 #include "publisher.hpp"
+#include "queued_publisher.hpp"
+#include "retrying_publisher.hpp"
 #include "subscriber.hpp"
+#include "local_subscriber.hpp"
+#include "local_subscription.hpp"
+#include "topic_statistics.hpp"
+#include "statistics_publisher.hpp"
+#include "clock.hpp"
+#include "reconnect_supervisor.hpp"
+#include "trace.hpp"
+#include "latency_probe.hpp"
 #include "service_server.hpp"
+#include "guard_condition.hpp"
+#include "batching_publisher.hpp"
+#include "batching_subscriber.hpp"
+#include "stream_publisher.hpp"
+#include "stream_subscriber.hpp"
+#include "callback_pool.hpp"
+#include "pooled_subscriber.hpp"
+#include "simd.hpp"
+#include "spin_hook.hpp"
+#include "coroutine.hpp"
+#include "mpsc_queue.hpp"
+#include "threading.hpp"
+#include "static_arena.hpp"
+#include "entity_graph.hpp"
 
 #include "message.hpp"
 #include "service.hpp"
+#include "multi_array.hpp"
+#include "reflection.hpp"
+#include "serialization.hpp"
 
 namespace rclc_cppb {}
\ No newline at end of file
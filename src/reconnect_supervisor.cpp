@@ -0,0 +1,79 @@
+#include "reconnect_supervisor.hpp"
+
+#include <Arduino.h>
+
+namespace rclc_cppb
+{
+  ReconnectSupervisor::ReconnectSupervisor(
+    uint64_t ping_period_ns,
+    int ping_timeout_ms,
+    uint8_t ping_attempts
+  ) noexcept:
+    _ping_period_ns(ping_period_ns),
+    _ping_timeout_ms(ping_timeout_ms),
+    _ping_attempts(ping_attempts)
+  {
+    
+  }
+
+  bool ReconnectSupervisor::check(void) noexcept
+  {
+    if(!this->_is_lost && !Node::is_session_up())
+    {
+      // Nothing to supervise until the nodes are set up
+      return false;
+    }
+    const unsigned long now_us = micros();
+    if(this->_has_pinged && RCL_US_TO_NS((uint64_t)(now_us - this->_last_ping_us)) < this->_ping_period_ns)
+    {
+      return !this->_is_lost;
+    }
+    this->_last_ping_us = now_us;
+    this->_has_pinged = true;
+
+    // Called directly, since a failing ping is expected and not an error
+    const bool is_reachable = rmw_uros_ping_agent(this->_ping_timeout_ms, this->_ping_attempts) == RMW_RET_OK;
+    if(!this->_is_lost)
+    {
+      if(is_reachable)
+      {
+        this->_lost_message_mark = Handle::get_lost_message_count();
+        return true;
+      }
+      this->_is_lost = true;
+      this->_lost_us = now_us;
+      this->_stats.loss_count++;
+      Node::teardown_session();
+      return false;
+    }
+
+    if(!is_reachable || !Node::restore_session())
+    {
+      return false;
+    }
+    this->_is_lost = false;
+
+    const unsigned long reconnect_ms = (micros() - this->_lost_us)/1000;
+    const uint32_t lost_message_count = Handle::get_lost_message_count();
+    this->_stats.reconnect_count++;
+    this->_stats.last_reconnect_ms = reconnect_ms;
+    if(reconnect_ms > this->_stats.max_reconnect_ms)
+    {
+      this->_stats.max_reconnect_ms = reconnect_ms;
+    }
+    this->_stats.last_lost_message_count = lost_message_count - this->_lost_message_mark;
+    this->_stats.lost_message_count += this->_stats.last_lost_message_count;
+    this->_lost_message_mark = lost_message_count;
+    return true;
+  }
+
+  bool ReconnectSupervisor::is_connected(void) const noexcept
+  {
+    return !this->_is_lost;
+  }
+
+  const ReconnectStats& ReconnectSupervisor::get_stats(void) const noexcept
+  {
+    return this->_stats;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <micro_ros_arduino.h>
+#include <rmw_microros/rmw_microros.h>
+#include <rcl/rcl.h>
+
+#include "node.hpp"
+#include "handle.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Statistics of a reconnect supervisor, see @see{ReconnectSupervisor::get_stats}
+  */
+  struct ReconnectStats
+  {
+    /**
+     * Amount of times the session to the agent was lost
+    */
+    uint32_t loss_count;
+    /**
+     * Amount of times the session to the agent was restored
+    */
+    uint32_t reconnect_count;
+    /**
+     * Time in milliseconds from the last loss until the session was restored
+    */
+    unsigned long last_reconnect_ms;
+    /**
+     * Longest time in milliseconds from a loss until the session was restored
+    */
+    unsigned long max_reconnect_ms;
+    /**
+     * Amount of messages lost during the last outage, counted from the last successful ping before it
+    */
+    uint32_t last_lost_message_count;
+    /**
+     * Amount of messages lost during all outages
+    */
+    uint32_t lost_message_count;
+  };
+
+  /**
+   * Supervisor which pings the agent, and restores everything once the session to it is lost and the agent is back.
+   *
+   * When a ping fails, all entities, nodes, executors and the rclc support are finalized without waiting for the agent.
+   * Once the agent answers again, they are all created again in one pass: every node which was set up
+   * is set up again, which calls its on_setup, and every entity which was created is created again,
+   * including those created outside of on_setup.
+   *
+   * Usage instructions:
+   * - Instantiate one supervisor.
+   * - Set up the nodes as usual.
+   * - Call check() once every loop-cycle, which pings no more often than the ping period.
+   *   Publishing fails while it returns false, and such messages are counted as lost.
+  */
+  class ReconnectSupervisor
+  {
+    public:
+      /**
+       * Default ping period in nanoseconds
+      */
+      static constexpr uint64_t DEFAULT_PING_PERIOD_NS = RCL_MS_TO_NS(500);
+      /**
+       * Default ping timeout in milliseconds
+      */
+      static constexpr int DEFAULT_PING_TIMEOUT_MS = 20;
+      /**
+       * Default amount of ping attempts before the session is considered lost
+      */
+      static constexpr uint8_t DEFAULT_PING_ATTEMPTS = 2;
+    private:
+      /**
+       * Ping period in nanoseconds
+      */
+      const uint64_t _ping_period_ns;
+      /**
+       * Ping timeout in milliseconds
+      */
+      const int _ping_timeout_ms;
+      /**
+       * Amount of ping attempts before the session is considered lost
+      */
+      const uint8_t _ping_attempts;
+      /**
+       * Time of the last ping, in microseconds
+      */
+      unsigned long _last_ping_us = 0;
+      /**
+       * true once the agent has been pinged
+      */
+      bool _has_pinged = false;
+      /**
+       * true while the session is considered lost
+      */
+      bool _is_lost = false;
+      /**
+       * Time when the session was lost, in microseconds
+      */
+      unsigned long _lost_us = 0;
+      /**
+       * Amount of lost messages as of the last successful ping
+      */
+      uint32_t _lost_message_mark = 0;
+      /**
+       * Statistics
+      */
+      ReconnectStats _stats = {};
+
+    public:
+      /**
+       * Supervisor which pings the agent, and restores everything once the session to it is lost and the agent is back.
+       * @param ping_period_ns Ping period in nanoseconds, both while connected and while waiting for the agent
+       * @param ping_timeout_ms Timeout of each ping attempt in milliseconds
+       * @param ping_attempts Amount of ping attempts before the session is considered lost
+      */
+      explicit ReconnectSupervisor(
+        uint64_t ping_period_ns = ReconnectSupervisor::DEFAULT_PING_PERIOD_NS,
+        int ping_timeout_ms = ReconnectSupervisor::DEFAULT_PING_TIMEOUT_MS,
+        uint8_t ping_attempts = ReconnectSupervisor::DEFAULT_PING_ATTEMPTS
+      ) noexcept;
+      ReconnectSupervisor(const ReconnectSupervisor&) = delete;
+
+      /**
+       * Pings the agent once the ping period has elapsed. Tears everything down if the session is lost,
+       * and restores everything once the agent answers again.
+       * Blocks for at most the ping timeout times the amount of attempts, and for restoring.
+       * @return true if the session is up
+      */
+      bool check(void) noexcept;
+      /**
+       * Returns true unless the session is considered lost
+      */
+      bool is_connected(void) const noexcept;
+      /**
+       * Retrieves the statistics of this supervisor
+       * @return Reference to statistics
+      */
+      const ReconnectStats& get_stats(void) const noexcept;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,404 @@
+#ifndef RCLC_CPPB__REFLECTION_H_
+  #define RCLC_CPPB__REFLECTION_H_
+
+  #include <stdint.h>
+  #include <stddef.h>
+  #include <string.h>
+  #include <type_traits>
+  #include <utility>
+
+  #include <rcl/rcl.h>
+
+  namespace rclc_cppb
+  {
+    /**
+     * How a reflected type is laid out
+    */
+    enum class FieldKind: uint8_t
+    {
+      /**
+       * Type is not reflected
+      */
+      UNKNOWN = 0,
+      /**
+       * Arithmetic or enum type
+      */
+      SCALAR = 1,
+      /**
+       * Fixed-size C array of a reflected type
+      */
+      ARRAY = 2,
+      /**
+       * rosidl sequence or string, with data, size and capacity members
+      */
+      SEQUENCE = 3,
+      /**
+       * Struct with declared fields
+      */
+      STRUCT = 4
+    };
+
+    /**
+     * Compile-time descriptor of one field in a struct.
+     *
+     * @param <_StructType> Type of struct containing the field
+     * @param <_FieldType> Type of the field
+     * @param <MEMBER> Pointer to the field member, put @code{&StructType::field_name}
+    */
+    template<typename _StructType, typename _FieldType, _FieldType _StructType::* MEMBER>
+    struct Field
+    {
+      /**
+       * Type of struct containing the field
+      */
+      using StructType = _StructType;
+      /**
+       * Type of the field
+      */
+      using FieldType = _FieldType;
+
+      /**
+       * Retrieves reference to the field within a struct
+       * @param value Struct
+       * @return Reference to field
+      */
+      static constexpr const FieldType& get(const StructType& value) noexcept
+      {
+        return value.*MEMBER;
+      }
+      /**
+       * Retrieves mutable reference to the field within a struct
+       * @param value Struct
+       * @return Mutable reference to field
+      */
+      static constexpr FieldType& get_mut(StructType& value) noexcept
+      {
+        return value.*MEMBER;
+      }
+    };
+
+    template<typename... _Fields>
+    struct FieldList;
+    template<typename _Type>
+    struct SequenceReflection;
+
+    /**
+     * true if type is a rosidl sequence or string, i.e. has pointer member data, and members size and capacity
+    */
+    template<typename _Type, typename = void>
+    struct IsSequence: std::false_type {};
+    template<typename _Type>
+    struct IsSequence<
+      _Type,
+      std::void_t<
+        decltype(std::declval<_Type>().size),
+        decltype(std::declval<_Type>().capacity),
+        std::enable_if_t<std::is_pointer<decltype(std::declval<_Type>().data)>::value>
+      >
+    >: std::true_type {};
+
+    /**
+     * Reflection trait.
+     *
+     * Describes the fields of a message type at compile time,
+     * so that copying, comparison, hashing and fixed-size detection can be derived from it.
+     *
+     * Scalars, fixed-size arrays and rosidl sequences and strings are reflected automatically.
+     * Structs are reflected by listing their fields once with the REFLECT_IMPL macro.
+     * Already implemented for the non-sequence types in std_msgs that are included before this library.
+     *
+     * @param <_Type> The type for which the trait is implemented
+    */
+    template<typename _Type>
+    struct Reflection
+    {
+      /**
+       * Public export of _Type
+      */
+      using Type = _Type;
+      /**
+       * Fields of the type, empty unless type is a struct
+      */
+      using Fields = FieldList<>;
+
+      /**
+       * Layout of the type
+      */
+      constexpr static const FieldKind KIND = std::is_arithmetic<_Type>::value || std::is_enum<_Type>::value
+        ? FieldKind::SCALAR
+        : FieldKind::UNKNOWN;
+      /**
+       * true if trait is implemented
+       *
+       * Please override this and set to true in implementation
+      */
+      constexpr static const bool IS_IMPL = KIND != FieldKind::UNKNOWN;
+      /**
+       * true if the type does not refer to memory outside of itself
+      */
+      constexpr static const bool IS_FIXED_SIZE = IS_IMPL;
+      /**
+       * Size of the type without padding
+      */
+      constexpr static const size_t PACKED_SIZE = IS_IMPL ? sizeof(_Type) : 0;
+    };
+
+    /**
+     * Compile-time reflection of a type, resolving sequences automatically
+    */
+    template<typename _Type>
+    using Reflect = std::conditional_t<
+      IsSequence<_Type>::value && !Reflection<_Type>::IS_IMPL,
+      SequenceReflection<_Type>,
+      Reflection<_Type>
+    >;
+
+    template<typename _ElementType, size_t LENGTH>
+    struct Reflection<_ElementType[LENGTH]>
+    {
+      using Type = _ElementType[LENGTH];
+      using ElementType = _ElementType;
+      using Fields = FieldList<>;
+
+      constexpr static const FieldKind KIND = FieldKind::ARRAY;
+      constexpr static const bool IS_IMPL = Reflect<ElementType>::IS_IMPL;
+      constexpr static const bool IS_FIXED_SIZE = Reflect<ElementType>::IS_FIXED_SIZE;
+      constexpr static const size_t PACKED_SIZE = Reflect<ElementType>::PACKED_SIZE*LENGTH;
+    };
+
+    /**
+     * Reflection of rosidl sequences and strings
+    */
+    template<typename _Type>
+    struct SequenceReflection
+    {
+      using Type = _Type;
+      using ElementType = std::remove_pointer_t<decltype(std::declval<_Type>().data)>;
+      using Fields = FieldList<>;
+
+      constexpr static const FieldKind KIND = FieldKind::SEQUENCE;
+      constexpr static const bool IS_IMPL = Reflect<ElementType>::IS_IMPL;
+      constexpr static const bool IS_FIXED_SIZE = false;
+      constexpr static const size_t PACKED_SIZE = 0;
+    };
+
+    /**
+     * Compile-time list of field descriptors of a struct.
+     *
+     * @param <_Fields> Field descriptors, see @see{Field}
+    */
+    template<typename... _Fields>
+    struct FieldList
+    {
+      /**
+       * Amount of fields
+      */
+      constexpr static const size_t COUNT = sizeof...(_Fields);
+      /**
+       * true if all fields are reflected
+      */
+      constexpr static const bool IS_IMPL = (Reflect<typename _Fields::FieldType>::IS_IMPL && ...);
+      /**
+       * true if no field refers to memory outside of the struct
+      */
+      constexpr static const bool IS_FIXED_SIZE = (Reflect<typename _Fields::FieldType>::IS_FIXED_SIZE && ...);
+      /**
+       * Sum of field sizes, not counting padding
+      */
+      constexpr static const size_t PACKED_SIZE = (0 + ... + Reflect<typename _Fields::FieldType>::PACKED_SIZE);
+    };
+
+    namespace reflection
+    {
+      /**
+       * true if values of the type can be copied, compared and hashed as raw bytes,
+       * meaning it refers to no outside memory and contains no padding
+      */
+      template<typename _Type>
+      constexpr bool is_packed(void) noexcept;
+
+      /**
+       * Copies value field by field.
+       * Sequences are copied into the memory already held by the destination, never allocating.
+       * Fixed-size types are copied with a single memcpy.
+       * @param destination Value to copy into
+       * @param source Value to copy from
+       * @return false if a sequence was truncated to fit the capacity of the destination
+      */
+      template<typename _Type>
+      bool copy(_Type& destination, const _Type& source) noexcept;
+      /**
+       * Compares values field by field, bitwise for scalars.
+       * Packed types are compared with a single memcmp.
+       * @param a Value
+       * @param b Value
+       * @return true if equal
+      */
+      template<typename _Type>
+      bool equals(const _Type& a, const _Type& b) noexcept;
+      /**
+       * Finds which top-level fields of a struct differ.
+       * @param a Value
+       * @param b Value
+       * @return Bitmask where bit n is set if field n differs
+      */
+      template<typename _Type>
+      uint32_t diff(const _Type& a, const _Type& b) noexcept;
+      /**
+       * Hashes value field by field with 32-bit FNV-1a.
+       * Values that are equal according to @see{equals} hash equally.
+       * @param value Value
+       * @param seed Hash to continue from
+       * @return Hash
+      */
+      template<typename _Type>
+      uint32_t hash(const _Type& value, uint32_t seed = 2166136261u) noexcept;
+    }
+  }
+
+  #define _REFLECT_FIELD(STRUCT_TYPE, FIELD_NAME) \
+    rclc_cppb::Field<STRUCT_TYPE, decltype(STRUCT_TYPE::FIELD_NAME), &STRUCT_TYPE::FIELD_NAME>
+  #define _REFLECT_FIELDS_1(T, F) _REFLECT_FIELD(T, F)
+  #define _REFLECT_FIELDS_2(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_1(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_3(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_2(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_4(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_3(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_5(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_4(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_6(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_5(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_7(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_6(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_8(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_7(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_9(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_8(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_10(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_9(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_11(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_10(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_12(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_11(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_13(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_12(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_14(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_13(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_15(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_14(T, __VA_ARGS__)
+  #define _REFLECT_FIELDS_16(T, F, ...) _REFLECT_FIELD(T, F), _REFLECT_FIELDS_15(T, __VA_ARGS__)
+  #define _GET_REFLECT_FIELDS_MACRO( \
+    _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, NAME, ... \
+  ) NAME
+  #define _REFLECT_FIELDS(T, ...) _GET_REFLECT_FIELDS_MACRO(__VA_ARGS__, \
+    _REFLECT_FIELDS_16, _REFLECT_FIELDS_15, _REFLECT_FIELDS_14, _REFLECT_FIELDS_13, \
+    _REFLECT_FIELDS_12, _REFLECT_FIELDS_11, _REFLECT_FIELDS_10, _REFLECT_FIELDS_9, \
+    _REFLECT_FIELDS_8, _REFLECT_FIELDS_7, _REFLECT_FIELDS_6, _REFLECT_FIELDS_5, \
+    _REFLECT_FIELDS_4, _REFLECT_FIELDS_3, _REFLECT_FIELDS_2, _REFLECT_FIELDS_1 \
+  )(T, __VA_ARGS__)
+
+  /**
+   * Implements the Reflection trait for a struct by listing its fields, in declaration order.
+   * Supports up to 16 fields.
+   * Usage: @code{REFLECT_IMPL(std_msgs__msg__ColorRGBA, r, g, b, a)}
+  */
+  #define REFLECT_IMPL(STRUCT_TYPE, ...) \
+  template<> \
+  struct rclc_cppb::Reflection<STRUCT_TYPE> \
+  { \
+    using Type = STRUCT_TYPE; \
+    using Fields = rclc_cppb::FieldList<_REFLECT_FIELDS(STRUCT_TYPE, __VA_ARGS__)>; \
+     \
+    constexpr static const rclc_cppb::FieldKind KIND = rclc_cppb::FieldKind::STRUCT; \
+    constexpr static const bool IS_IMPL = Fields::IS_IMPL; \
+    constexpr static const bool IS_FIXED_SIZE = Fields::IS_FIXED_SIZE; \
+    constexpr static const size_t PACKED_SIZE = Fields::PACKED_SIZE; \
+  };
+
+  #include "reflection_impl.hpp"
+#endif
+
+// Nested message types are often only included through their detail struct header
+#if ( \
+  defined(BUILTIN_INTERFACES__MSG__TIME_H_) || \
+  defined(BUILTIN_INTERFACES__MSG__DETAIL__TIME__STRUCT_H_) \
+) && !defined(RCLC_CPPB__REFLECTION_H__TIME_)
+  #define RCLC_CPPB__REFLECTION_H__TIME_
+  REFLECT_IMPL(builtin_interfaces__msg__Time, sec, nanosec)
+#endif
+
+#if defined(STD_MSGS__MSG__STRING_H_) && !defined(RCLC_CPPB__REFLECTION_H__STRING_)
+  #define RCLC_CPPB__REFLECTION_H__STRING_
+  REFLECT_IMPL(std_msgs__msg__String, data)
+#endif
+#if defined(STD_MSGS__MSG__EMPTY_H_) && !defined(RCLC_CPPB__REFLECTION_H__EMPTY_)
+  #define RCLC_CPPB__REFLECTION_H__EMPTY_
+  REFLECT_IMPL(std_msgs__msg__Empty, structure_needs_at_least_one_member)
+#endif
+#if defined(STD_MSGS__MSG__BOOL_H_) && !defined(RCLC_CPPB__REFLECTION_H__BOOL_)
+  #define RCLC_CPPB__REFLECTION_H__BOOL_
+  REFLECT_IMPL(std_msgs__msg__Bool, data)
+#endif
+
+#if defined(STD_MSGS__MSG__U_INT8_H_) && !defined(RCLC_CPPB__REFLECTION_H__U_INT8_)
+  #define RCLC_CPPB__REFLECTION_H__U_INT8_
+  REFLECT_IMPL(std_msgs__msg__UInt8, data)
+#endif
+#if defined(STD_MSGS__MSG__U_INT16_H_) && !defined(RCLC_CPPB__REFLECTION_H__U_INT16_)
+  #define RCLC_CPPB__REFLECTION_H__U_INT16_
+  REFLECT_IMPL(std_msgs__msg__UInt16, data)
+#endif
+#if defined(STD_MSGS__MSG__U_INT32_H_) && !defined(RCLC_CPPB__REFLECTION_H__U_INT32_)
+  #define RCLC_CPPB__REFLECTION_H__U_INT32_
+  REFLECT_IMPL(std_msgs__msg__UInt32, data)
+#endif
+#if defined(STD_MSGS__MSG__U_INT64_H_) && !defined(RCLC_CPPB__REFLECTION_H__U_INT64_)
+  #define RCLC_CPPB__REFLECTION_H__U_INT64_
+  REFLECT_IMPL(std_msgs__msg__UInt64, data)
+#endif
+#if defined(STD_MSGS__MSG__BYTE_H_) && !defined(RCLC_CPPB__REFLECTION_H__BYTE_)
+  #define RCLC_CPPB__REFLECTION_H__BYTE_
+  REFLECT_IMPL(std_msgs__msg__Byte, data)
+#endif
+#if defined(STD_MSGS__MSG__CHAR_H_) && !defined(RCLC_CPPB__REFLECTION_H__CHAR_)
+  #define RCLC_CPPB__REFLECTION_H__CHAR_
+  REFLECT_IMPL(std_msgs__msg__Char, data)
+#endif
+
+#if defined(STD_MSGS__MSG__INT8_H_) && !defined(RCLC_CPPB__REFLECTION_H__INT8_)
+  #define RCLC_CPPB__REFLECTION_H__INT8_
+  REFLECT_IMPL(std_msgs__msg__Int8, data)
+#endif
+#if defined(STD_MSGS__MSG__INT16_H_) && !defined(RCLC_CPPB__REFLECTION_H__INT16_)
+  #define RCLC_CPPB__REFLECTION_H__INT16_
+  REFLECT_IMPL(std_msgs__msg__Int16, data)
+#endif
+#if defined(STD_MSGS__MSG__INT32_H_) && !defined(RCLC_CPPB__REFLECTION_H__INT32_)
+  #define RCLC_CPPB__REFLECTION_H__INT32_
+  REFLECT_IMPL(std_msgs__msg__Int32, data)
+#endif
+#if defined(STD_MSGS__MSG__INT64_H_) && !defined(RCLC_CPPB__REFLECTION_H__INT64_)
+  #define RCLC_CPPB__REFLECTION_H__INT64_
+  REFLECT_IMPL(std_msgs__msg__Int64, data)
+#endif
+
+#if defined(STD_MSGS__MSG__FLOAT32_H_) && !defined(RCLC_CPPB__REFLECTION_H__FLOAT32_)
+  #define RCLC_CPPB__REFLECTION_H__FLOAT32_
+  REFLECT_IMPL(std_msgs__msg__Float32, data)
+#endif
+#if defined(STD_MSGS__MSG__FLOAT64_H_) && !defined(RCLC_CPPB__REFLECTION_H__FLOAT64_)
+  #define RCLC_CPPB__REFLECTION_H__FLOAT64_
+  REFLECT_IMPL(std_msgs__msg__Float64, data)
+#endif
+
+#if ( \
+  defined(STD_MSGS__MSG__MULTI_ARRAY_DIMENSION_H_) || \
+  defined(STD_MSGS__MSG__DETAIL__MULTI_ARRAY_DIMENSION__STRUCT_H_) \
+) && !defined(RCLC_CPPB__REFLECTION_H__MULTI_ARRAY_DIMENSION_)
+  #define RCLC_CPPB__REFLECTION_H__MULTI_ARRAY_DIMENSION_
+  REFLECT_IMPL(std_msgs__msg__MultiArrayDimension, label, size, stride)
+#endif
+#if ( \
+  defined(STD_MSGS__MSG__MULTI_ARRAY_LAYOUT_H_) || \
+  defined(STD_MSGS__MSG__DETAIL__MULTI_ARRAY_LAYOUT__STRUCT_H_) \
+) && !defined(RCLC_CPPB__REFLECTION_H__MULTI_ARRAY_LAYOUT_)
+  #define RCLC_CPPB__REFLECTION_H__MULTI_ARRAY_LAYOUT_
+  REFLECT_IMPL(std_msgs__msg__MultiArrayLayout, dim, data_offset)
+#endif
+
+#if defined(STD_MSGS__MSG__HEADER_H_) && !defined(RCLC_CPPB__REFLECTION_H__HEADER_)
+  #define RCLC_CPPB__REFLECTION_H__HEADER_
+  REFLECT_IMPL(std_msgs__msg__Header, stamp, frame_id)
+#endif
+
+#if defined(STD_MSGS__MSG__COLOR_RGBA_H_) && !defined(RCLC_CPPB__REFLECTION_H__COLOR_RGBA_)
+  #define RCLC_CPPB__REFLECTION_H__COLOR_RGBA_
+  REFLECT_IMPL(std_msgs__msg__ColorRGBA, r, g, b, a)
+#endif
\ No newline at end of file
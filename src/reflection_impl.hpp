@@ -0,0 +1,194 @@
+#pragma once
+
+#include "reflection.hpp"
+
+namespace rclc_cppb::reflection
+{
+  /**
+   * Continues a 32-bit FNV-1a hash over raw bytes
+  */
+  inline uint32_t hash_bytes(const void* bytes, size_t length, uint32_t seed) noexcept
+  {
+    const uint8_t* data = (const uint8_t*)bytes;
+    for(size_t i = 0; i < length; i++)
+    {
+      seed = (seed ^ data[i])*16777619u;
+    }
+    return seed;
+  }
+
+  template<typename... _Fields, typename _Type>
+  bool copy_fields(FieldList<_Fields...>, _Type& destination, const _Type& source) noexcept
+  {
+    bool complete = true;
+    ((complete = copy(_Fields::get_mut(destination), _Fields::get(source)) && complete), ...);
+    return complete;
+  }
+  template<typename... _Fields, typename _Type>
+  bool equals_fields(FieldList<_Fields...>, const _Type& a, const _Type& b) noexcept
+  {
+    return (equals(_Fields::get(a), _Fields::get(b)) && ...);
+  }
+  template<typename... _Fields, typename _Type, size_t... INDICES>
+  uint32_t diff_fields(FieldList<_Fields...>, std::index_sequence<INDICES...>, const _Type& a, const _Type& b) noexcept
+  {
+    return (0u | ... | (equals(_Fields::get(a), _Fields::get(b)) ? 0u : (1u << INDICES)));
+  }
+  template<typename... _Fields, typename _Type>
+  uint32_t hash_fields(FieldList<_Fields...>, const _Type& value, uint32_t seed) noexcept
+  {
+    ((seed = hash(_Fields::get(value), seed)), ...);
+    return seed;
+  }
+
+  template<typename _Type>
+  constexpr bool is_packed(void) noexcept
+  {
+    return Reflect<_Type>::IS_IMPL
+      && Reflect<_Type>::IS_FIXED_SIZE
+      && Reflect<_Type>::PACKED_SIZE == sizeof(_Type);
+  }
+
+  template<typename _Type>
+  bool copy(_Type& destination, const _Type& source) noexcept
+  {
+    using Reflected = Reflect<_Type>;
+    static_assert(Reflected::IS_IMPL, "Trait Reflection must be implemented!");
+
+    if constexpr(Reflected::IS_FIXED_SIZE)
+    {
+      memcpy(&destination, &source, sizeof(_Type));
+      return true;
+    }
+    else if constexpr(Reflected::KIND == FieldKind::ARRAY)
+    {
+      bool complete = true;
+      for(size_t i = 0; i < sizeof(_Type)/sizeof(destination[0]); i++)
+      {
+        complete = copy(destination[i], source[i]) && complete;
+      }
+      return complete;
+    }
+    else if constexpr(Reflected::KIND == FieldKind::SEQUENCE)
+    {
+      using ElementType = typename Reflected::ElementType;
+      // Strings keep room for null-termination
+      constexpr size_t RESERVED = std::is_same<ElementType, char>::value ? 1 : 0;
+
+      if(destination.data == source.data)
+      {
+        return true;
+      }
+      const size_t room = destination.capacity > RESERVED ? destination.capacity - RESERVED : 0;
+      const size_t size = source.size < room ? source.size : room;
+      bool complete = size == source.size;
+      for(size_t i = 0; i < size; i++)
+      {
+        complete = copy(destination.data[i], source.data[i]) && complete;
+      }
+      if constexpr(RESERVED > 0)
+      {
+        if(destination.capacity > 0)
+        {
+          destination.data[size] = '\0';
+        }
+      }
+      destination.size = size;
+      return complete;
+    }
+    else
+    {
+      return copy_fields(typename Reflected::Fields(), destination, source);
+    }
+  }
+
+  template<typename _Type>
+  bool equals(const _Type& a, const _Type& b) noexcept
+  {
+    using Reflected = Reflect<_Type>;
+    static_assert(Reflected::IS_IMPL, "Trait Reflection must be implemented!");
+
+    if constexpr(is_packed<_Type>() || Reflected::KIND == FieldKind::SCALAR)
+    {
+      return memcmp(&a, &b, sizeof(_Type)) == 0;
+    }
+    else if constexpr(Reflected::KIND == FieldKind::ARRAY)
+    {
+      for(size_t i = 0; i < sizeof(_Type)/sizeof(a[0]); i++)
+      {
+        if(!equals(a[i], b[i]))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    else if constexpr(Reflected::KIND == FieldKind::SEQUENCE)
+    {
+      if(a.size != b.size)
+      {
+        return false;
+      }
+      for(size_t i = 0; i < a.size; i++)
+      {
+        if(!equals(a.data[i], b.data[i]))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    else
+    {
+      return equals_fields(typename Reflected::Fields(), a, b);
+    }
+  }
+
+  template<typename _Type>
+  uint32_t diff(const _Type& a, const _Type& b) noexcept
+  {
+    using Reflected = Reflect<_Type>;
+    static_assert(Reflected::KIND == FieldKind::STRUCT, "Only structs with trait Reflection implemented can be diffed!");
+    static_assert(Reflected::Fields::COUNT <= 32, "Only structs with up to 32 fields can be diffed!");
+
+    return diff_fields(
+      typename Reflected::Fields(),
+      std::make_index_sequence<Reflected::Fields::COUNT>(),
+      a,
+      b
+    );
+  }
+
+  template<typename _Type>
+  uint32_t hash(const _Type& value, uint32_t seed) noexcept
+  {
+    using Reflected = Reflect<_Type>;
+    static_assert(Reflected::IS_IMPL, "Trait Reflection must be implemented!");
+
+    if constexpr(is_packed<_Type>() || Reflected::KIND == FieldKind::SCALAR)
+    {
+      return hash_bytes(&value, sizeof(_Type), seed);
+    }
+    else if constexpr(Reflected::KIND == FieldKind::ARRAY)
+    {
+      for(size_t i = 0; i < sizeof(_Type)/sizeof(value[0]); i++)
+      {
+        seed = hash(value[i], seed);
+      }
+      return seed;
+    }
+    else if constexpr(Reflected::KIND == FieldKind::SEQUENCE)
+    {
+      seed = hash_bytes(&value.size, sizeof(value.size), seed);
+      for(size_t i = 0; i < value.size; i++)
+      {
+        seed = hash(value.data[i], seed);
+      }
+      return seed;
+    }
+    else
+    {
+      return hash_fields(typename Reflected::Fields(), value, seed);
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <type_traits>
+
+#include "node.hpp"
+#include "spin_hook.hpp"
+#include "threading.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Policy of retrying failed sends, see @see{RetryQueue}
+  */
+  struct RetryPolicy
+  {
+    /**
+     * Maximum amount of attempts per message, the first one included, after which it is dropped
+    */
+    uint8_t max_attempts;
+    /**
+     * Time in nanoseconds to wait before the first retry, doubled for every further retry
+    */
+    uint64_t initial_backoff_ns;
+    /**
+     * Longest time in nanoseconds to wait before a retry
+    */
+    uint64_t max_backoff_ns;
+  };
+
+  /**
+   * Small outbound queue of messages whose sending failed, retried with exponential backoff.
+   *
+   * A message failing to send is queued and retried on a later spin, see @see{SpinHook},
+   * once its backoff has passed. Adaptive spins wake up for the retry, so nothing busy-waits,
+   * and submitting never waits for a pending retry. Messages are sent in order:
+   * while messages are queued, new ones are queued behind them.
+   * A message is dropped once it has failed the maximum amount of attempts.
+   *
+   * Failures handled as ERROR_LOOP are not transient; only ERROR_ONCE ones (RCL_RET_ERROR, RCL_RET_TIMEOUT)
+   * are worth retrying, so keep max_attempts small.
+   * Not safe from interrupt service routines, see @see{QueuedPublisher} for those.
+   * @param <_DataType> Type of queued message data, which must be trivially copyable
+   * @param <CAPACITY> Maximum amount of queued messages
+  */
+  template<typename _DataType, size_t CAPACITY>
+  class RetryQueue: SpinHook
+  {
+    static_assert(CAPACITY > 0, "Capacity must be at least one!");
+    static_assert(std::is_trivially_copyable<_DataType>::value, "Message data must be trivially copyable!");
+
+    public:
+      /**
+       * Type of queued message data
+      */
+      using DataType = _DataType;
+
+      /**
+       * Default retry policy: 4 attempts, with backoffs of 10, 20 and 40 milliseconds
+      */
+      static constexpr RetryPolicy DEFAULT_POLICY = {4, RCL_MS_TO_NS(10), RCL_MS_TO_NS(500)};
+    private:
+      /**
+       * A queued message
+      */
+      struct Entry
+      {
+        /**
+         * Message data
+        */
+        DataType data;
+        /**
+         * Amount of attempts made to send it
+        */
+        uint8_t attempt_count;
+      };
+
+      /**
+       * Queued messages, as a ring
+      */
+      Entry _entries[CAPACITY];
+      /**
+       * Index of the oldest queued message
+      */
+      size_t _head = 0;
+      /**
+       * Amount of queued messages
+      */
+      size_t _count = 0;
+      /**
+       * Retry policy
+      */
+      RetryPolicy _policy;
+      /**
+       * Time in microseconds when the oldest queued message is retried
+      */
+      unsigned long _next_attempt_us = 0;
+      /**
+       * Amount of retries made
+      */
+      uint32_t _retry_count = 0;
+      /**
+       * Amount of messages dropped after failing every attempt
+      */
+      uint32_t _dropped_count = 0;
+      /**
+       * Amount of messages dropped because the queue was full
+      */
+      uint32_t _overflow_count = 0;
+      /**
+       * Guards the queue, but is never held while sending, as sending may spin
+      */
+      mutable threading::Mutex _mutex;
+
+    public:
+      /**
+       * Small outbound queue of messages whose sending failed, retried with exponential backoff.
+       * @param policy Retry policy
+      */
+      explicit RetryQueue(RetryPolicy policy) noexcept;
+      RetryQueue(const RetryQueue&) = delete;
+
+      /**
+       * Sets the retry policy, which applies from the next failure on
+       * @param policy Retry policy
+      */
+      void set_retry_policy(RetryPolicy policy) noexcept;
+      /**
+       * Retrieves the retry policy
+      */
+      RetryPolicy get_retry_policy(void) const noexcept;
+      /**
+       * Retrieves the amount of messages waiting to be sent or retried
+      */
+      size_t get_pending_count(void) const noexcept;
+      /**
+       * Retrieves the amount of retries made
+      */
+      uint32_t get_retry_count(void) const noexcept;
+      /**
+       * Retrieves the amount of messages dropped after failing every attempt
+      */
+      uint32_t get_dropped_count(void) const noexcept;
+      /**
+       * Retrieves the amount of messages dropped because the queue was full
+      */
+      uint32_t get_overflow_count(void) const noexcept;
+    protected:
+      /**
+       * Sends message data right away if nothing is queued, otherwise or upon failure queues it to be retried
+       * @param data Message data
+       * @return true if sent or queued, false if dropped
+      */
+      bool submit(const DataType& data) noexcept;
+      /**
+       * Sends message data once
+       * @param data Message data
+       * @return true if success
+      */
+      virtual bool send(const DataType& data) noexcept = 0;
+      /**
+       * Returns true once the entity sending is up, before which queued messages wait without being attempted
+      */
+      virtual bool is_ready(void) const noexcept = 0;
+
+      /**
+       * Retries the oldest queued messages whose backoff has passed
+      */
+      void on_spin(void) noexcept override;
+      /**
+       * Returns the time until the oldest queued message is retried, so that adaptive spins wake up for it
+      */
+      uint64_t get_time_until_due_ns(void) const noexcept override;
+    private:
+      /**
+       * Queues message data, the lock being held
+       * @param data Message data
+       * @param attempt_count Amount of attempts made to send it
+       * @return false if the queue was full and the data was dropped
+      */
+      bool enqueue(const DataType& data, uint8_t attempt_count) noexcept;
+      /**
+       * Derives the time to wait before the next attempt
+       * @param attempt_count Amount of attempts made so far
+       * @return Time in nanoseconds
+      */
+      uint64_t get_backoff_ns(uint8_t attempt_count) const noexcept;
+  };
+}
+
+#include "retry_queue_impl.hpp"
\ No newline at end of file
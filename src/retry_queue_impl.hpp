@@ -0,0 +1,168 @@
+#pragma once
+
+#include "retry_queue.hpp"
+
+namespace rclc_cppb
+{
+  template<typename _DataType, size_t CAPACITY>
+  RetryQueue<_DataType, CAPACITY>::RetryQueue(RetryPolicy policy) noexcept:
+    _policy(policy)
+  {
+
+  }
+
+  template<typename _DataType, size_t CAPACITY>
+  void RetryQueue<_DataType, CAPACITY>::set_retry_policy(RetryPolicy policy) noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    this->_policy = policy;
+  }
+  template<typename _DataType, size_t CAPACITY>
+  RetryPolicy RetryQueue<_DataType, CAPACITY>::get_retry_policy(void) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    return this->_policy;
+  }
+  template<typename _DataType, size_t CAPACITY>
+  size_t RetryQueue<_DataType, CAPACITY>::get_pending_count(void) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    return this->_count;
+  }
+  template<typename _DataType, size_t CAPACITY>
+  uint32_t RetryQueue<_DataType, CAPACITY>::get_retry_count(void) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    return this->_retry_count;
+  }
+  template<typename _DataType, size_t CAPACITY>
+  uint32_t RetryQueue<_DataType, CAPACITY>::get_dropped_count(void) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    return this->_dropped_count;
+  }
+  template<typename _DataType, size_t CAPACITY>
+  uint32_t RetryQueue<_DataType, CAPACITY>::get_overflow_count(void) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    return this->_overflow_count;
+  }
+
+  template<typename _DataType, size_t CAPACITY>
+  bool RetryQueue<_DataType, CAPACITY>::submit(const DataType& data) noexcept
+  {
+    {
+      threading::Lock lock(this->_mutex);
+      // Queued behind the pending messages, so that messages keep their order
+      if(this->_count > 0 || !this->is_ready())
+      {
+        return this->enqueue(data, 0);
+      }
+    }
+    if(this->send(data))
+    {
+      return true;
+    }
+
+    threading::Lock lock(this->_mutex);
+    if(this->_policy.max_attempts <= 1)
+    {
+      this->_dropped_count++;
+      return false;
+    }
+    if(this->_count == 0)
+    {
+      this->_next_attempt_us = micros() + (unsigned long)(this->get_backoff_ns(1)/1000);
+    }
+    return this->enqueue(data, 1);
+  }
+
+  template<typename _DataType, size_t CAPACITY>
+  bool RetryQueue<_DataType, CAPACITY>::enqueue(const DataType& data, uint8_t attempt_count) noexcept
+  {
+    if(this->_count == CAPACITY)
+    {
+      this->_overflow_count++;
+      return false;
+    }
+    Entry& entry = this->_entries[(this->_head + this->_count) % CAPACITY];
+    entry.data = data;
+    entry.attempt_count = attempt_count;
+    this->_count++;
+    return true;
+  }
+
+  template<typename _DataType, size_t CAPACITY>
+  uint64_t RetryQueue<_DataType, CAPACITY>::get_backoff_ns(uint8_t attempt_count) const noexcept
+  {
+    uint64_t backoff_ns = this->_policy.initial_backoff_ns;
+    for(uint8_t i = 1; i < attempt_count && backoff_ns < this->_policy.max_backoff_ns; i++)
+    {
+      backoff_ns *= 2;
+    }
+    return backoff_ns < this->_policy.max_backoff_ns ? backoff_ns : this->_policy.max_backoff_ns;
+  }
+
+  template<typename _DataType, size_t CAPACITY>
+  void RetryQueue<_DataType, CAPACITY>::on_spin(void) noexcept
+  {
+    if(!this->is_ready())
+    {
+      return;
+    }
+    // At most one queue-full per spin, and only the oldest message is retried, so that the order is kept
+    for(size_t i = 0; i < CAPACITY; i++)
+    {
+      Entry entry;
+      {
+        threading::Lock lock(this->_mutex);
+        if(this->_count == 0 || (long)(micros() - this->_next_attempt_us) < 0)
+        {
+          return;
+        }
+        entry = this->_entries[this->_head];
+        if(entry.attempt_count > 0)
+        {
+          this->_retry_count++;
+        }
+      }
+
+      const bool success = this->send(entry.data);
+
+      threading::Lock lock(this->_mutex);
+      const uint8_t attempt_count = entry.attempt_count + 1;
+      if(success)
+      {
+        this->_head = (this->_head + 1) % CAPACITY;
+        this->_count--;
+        continue;
+      }
+      if(attempt_count >= this->_policy.max_attempts)
+      {
+        this->_dropped_count++;
+        this->_head = (this->_head + 1) % CAPACITY;
+        this->_count--;
+        // The next message waits as well, as the link is likely to fail it too
+        this->_next_attempt_us = micros() + (unsigned long)(this->get_backoff_ns(1)/1000);
+      }
+      else
+      {
+        this->_entries[this->_head].attempt_count = attempt_count;
+        this->_next_attempt_us = micros() + (unsigned long)(this->get_backoff_ns(attempt_count)/1000);
+      }
+      return;
+    }
+  }
+
+  template<typename _DataType, size_t CAPACITY>
+  uint64_t RetryQueue<_DataType, CAPACITY>::get_time_until_due_ns(void) const noexcept
+  {
+    threading::Lock lock(this->_mutex);
+    if(this->_count == 0 || !this->is_ready())
+    {
+      return SpinHook::NEVER_DUE;
+    }
+    const long remaining_us = (long)(this->_next_attempt_us - micros());
+    return remaining_us > 0 ? RCL_US_TO_NS((uint64_t)remaining_us) : 0;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <micro_ros_arduino.h>
+#include <rcl/rcl.h>
+#include <rcl/error_handling.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+
+#include "message.hpp"
+#include "node.hpp"
+#include "publisher.hpp"
+#include "retry_queue.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Publisher which retries failed publishes with exponential backoff, see @see{RetryQueue}.
+   *
+   * Usage instructions:
+   * - Instantiate before any node is setup.
+   * - Call advertise() in on_setup-method of node or after node setup is completed.
+   * - Call publish() from the thread spinning the node, and spin the node as usual.
+   * - Message type must have Message trait implemented on it, with trivially copyable message data.
+   * @param <_MessageType> Message type handled by publisher
+   * @param <CAPACITY> Maximum amount of messages waiting to be retried
+  */
+  template<typename _MessageType, size_t CAPACITY>
+  class RetryingPublisher: public RetryQueue<typename Message<_MessageType>::DataType, CAPACITY>
+  {
+    static_assert(Message<_MessageType>::IS_IMPL, "Trait Message must be implemented!");
+
+    public:
+      /**
+       * Message type handled by publisher
+      */
+      using MessageType = _MessageType;
+      /**
+       * Internal data type of message
+      */
+      using DataType = typename Message<MessageType>::DataType;
+
+      /**
+       * Amount of executor handles needed by this publisher
+      */
+      static constexpr unsigned int HANDLE_COUNT = Publisher<MessageType>::HANDLE_COUNT;
+    private:
+      /**
+       * Publisher sending the messages
+      */
+      Publisher<MessageType> _publisher;
+      /**
+       * true if publisher has been successfully advertised
+      */
+      bool _is_advertised = false;
+
+    public:
+      /**
+       * Publisher which retries failed publishes with exponential backoff.
+       *
+       * Usage instructions:
+       * - Instantiate before any node is setup.
+       * - Call advertise() in on_setup-method of node or after node setup is completed.
+       * - Call publish() from the thread spinning the node, and spin the node as usual.
+       * @param <_MessageType> Message type handled by publisher
+       * @param <CAPACITY> Maximum amount of messages waiting to be retried
+       * @param node Pointer to node owning the publisher
+       * @param topic_name Topic name (slash and namespace of node is appended later)
+       * @param default_data Initial message data
+       * @param policy Retry policy
+      */
+      RetryingPublisher(
+        Node* node,
+        const char* topic_name,
+        DataType default_data,
+        RetryPolicy policy = RetryQueue<DataType, CAPACITY>::DEFAULT_POLICY
+      ) noexcept;
+
+      /**
+       * Initializes the publisher, and then advertises the topic onto the ROS2 network.
+       * Node must be successfully initialized for this to succeed.
+       * @return true if success
+      */
+      bool advertise(void) noexcept;
+
+      /**
+       * Publishes message data, or queues it to be retried if that fails or other messages are waiting.
+       * Never waits for a pending retry.
+       * @param data Message data
+       * @return true if published or queued, false if dropped
+      */
+      bool publish(DataType data) noexcept;
+    protected:
+      /**
+       * Publishes message data once
+       * @param data Message data
+       * @return true if success
+      */
+      bool send(const DataType& data) noexcept override;
+      /**
+       * Returns true once the publisher has been advertised
+      */
+      bool is_ready(void) const noexcept override;
+  };
+}
+
+#include "retrying_publisher_impl.hpp"
\ No newline at end of file
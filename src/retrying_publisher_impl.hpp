@@ -0,0 +1,48 @@
+#pragma once
+
+#include "retrying_publisher.hpp"
+
+namespace rclc_cppb
+{
+  template<typename _MessageType, size_t CAPACITY>
+  RetryingPublisher<_MessageType, CAPACITY>::RetryingPublisher(
+    Node* node,
+    const char* topic_name,
+    DataType default_data,
+    RetryPolicy policy
+  ) noexcept:
+    RetryQueue<DataType, CAPACITY>(policy),
+    _publisher(node, topic_name, default_data)
+  {
+
+  }
+
+  template<typename _MessageType, size_t CAPACITY>
+  bool RetryingPublisher<_MessageType, CAPACITY>::advertise(void) noexcept
+  {
+    if(!this->_publisher.advertise())
+    {
+      return false;
+    }
+    this->_is_advertised = true;
+    return true;
+  }
+
+  template<typename _MessageType, size_t CAPACITY>
+  bool RetryingPublisher<_MessageType, CAPACITY>::publish(DataType data) noexcept
+  {
+    return this->submit(data);
+  }
+
+  template<typename _MessageType, size_t CAPACITY>
+  bool RetryingPublisher<_MessageType, CAPACITY>::send(const DataType& data) noexcept
+  {
+    return this->_publisher.publish(data);
+  }
+
+  template<typename _MessageType, size_t CAPACITY>
+  bool RetryingPublisher<_MessageType, CAPACITY>::is_ready(void) const noexcept
+  {
+    return this->_is_advertised;
+  }
+}
\ No newline at end of file
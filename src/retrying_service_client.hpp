@@ -0,0 +1,109 @@
+#pragma once
+
+#include "message.hpp"
+#include "service.hpp"
+#include "node.hpp"
+#include "service_client.hpp"
+#include "retry_queue.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Service client which retries failed calls with exponential backoff, see @see{RetryQueue}.
+   * Only sending the request is retried; a request which was sent but never answered is not.
+   *
+   * Usage instructions:
+   * - Instantiate before any node is setup.
+   * - Call attach() in on_setup-method of node or after node setup is completed.
+   * - Call call() from the thread spinning the node, and spin the node as usual.
+   * - Message types must have Message trait implemented on them, with trivially copyable request data.
+   * - Message type pair must have Service trait implemented on them.
+   * @param <_RequestMessageType> Request message type handled by service client
+   * @param <_ResponseMessageType> Response message type handled by service client
+   * @param <CAPACITY> Maximum amount of requests waiting to be retried
+  */
+  template<typename _RequestMessageType, typename _ResponseMessageType, size_t CAPACITY>
+  class RetryingServiceClient: public RetryQueue<typename Message<_RequestMessageType>::DataType, CAPACITY>
+  {
+    public:
+      /**
+       * Service client sending the requests
+      */
+      using ClientType = ServiceClient<_RequestMessageType, _ResponseMessageType>;
+      /**
+       * Internal data type of request message
+      */
+      using RequestDataType = typename ClientType::RequestDataType;
+      /**
+       * Function-pointer type of callback function used by this service client
+      */
+      using CallbackType = typename ClientType::CallbackType;
+
+      /**
+       * Amount of executor handles needed by this service client
+      */
+      static constexpr unsigned int HANDLE_COUNT = ClientType::HANDLE_COUNT;
+    private:
+      /**
+       * Service client sending the requests
+      */
+      ClientType _client;
+      /**
+       * true if service client has been successfully attached
+      */
+      bool _is_attached = false;
+
+    public:
+      /**
+       * Service client which retries failed calls with exponential backoff.
+       *
+       * Usage instructions:
+       * - Instantiate before any node is setup.
+       * - Call attach() in on_setup-method of node or after node setup is completed.
+       * - Call call() from the thread spinning the node, and spin the node as usual.
+       * @param <_RequestMessageType> Request message type handled by service client
+       * @param <_ResponseMessageType> Response message type handled by service client
+       * @param <CAPACITY> Maximum amount of requests waiting to be retried
+       * @param node Pointer to node owning the service client
+       * @param service_name Service name (slash and namespace of node is appended later)
+       * @param callback Pointer to callback-function used by this service client
+       * @param default_request_data Initial request message data
+       * @param policy Retry policy
+      */
+      RetryingServiceClient(
+        Node* node,
+        const char* service_name,
+        CallbackType callback,
+        RequestDataType default_request_data,
+        RetryPolicy policy = RetryQueue<RequestDataType, CAPACITY>::DEFAULT_POLICY
+      ) noexcept;
+
+      /**
+       * Initializes the service client, and then attaches to the service on the ROS2 network.
+       * Node must be successfully initialized for this to succeed.
+       * @return true if success
+      */
+      bool attach(void) noexcept;
+
+      /**
+       * Calls the service with given request data, or queues the call to be retried
+       * if that fails or other calls are waiting. Never waits for a pending retry.
+       * @param request_data Request message data
+       * @return true if called or queued, false if dropped
+      */
+      bool call(RequestDataType request_data) noexcept;
+    protected:
+      /**
+       * Calls the service once
+       * @param request_data Request message data
+       * @return true if success
+      */
+      bool send(const RequestDataType& request_data) noexcept override;
+      /**
+       * Returns true once the service client has been attached
+      */
+      bool is_ready(void) const noexcept override;
+  };
+}
+
+#include "retrying_service_client_impl.hpp"
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "retrying_service_client.hpp"
+
+namespace rclc_cppb
+{
+  template<typename _RequestMessageType, typename _ResponseMessageType, size_t CAPACITY>
+  RetryingServiceClient<_RequestMessageType, _ResponseMessageType, CAPACITY>::RetryingServiceClient(
+    Node* node,
+    const char* service_name,
+    CallbackType callback,
+    RequestDataType default_request_data,
+    RetryPolicy policy
+  ) noexcept:
+    RetryQueue<RequestDataType, CAPACITY>(policy),
+    _client(node, service_name, callback, default_request_data)
+  {
+
+  }
+
+  template<typename _RequestMessageType, typename _ResponseMessageType, size_t CAPACITY>
+  bool RetryingServiceClient<_RequestMessageType, _ResponseMessageType, CAPACITY>::attach(void) noexcept
+  {
+    if(!this->_client.attach())
+    {
+      return false;
+    }
+    this->_is_attached = true;
+    return true;
+  }
+
+  template<typename _RequestMessageType, typename _ResponseMessageType, size_t CAPACITY>
+  bool RetryingServiceClient<_RequestMessageType, _ResponseMessageType, CAPACITY>::call(
+    RequestDataType request_data
+  ) noexcept
+  {
+    return this->submit(request_data);
+  }
+
+  template<typename _RequestMessageType, typename _ResponseMessageType, size_t CAPACITY>
+  bool RetryingServiceClient<_RequestMessageType, _ResponseMessageType, CAPACITY>::send(
+    const RequestDataType& request_data
+  ) noexcept
+  {
+    return this->_client.call(request_data);
+  }
+
+  template<typename _RequestMessageType, typename _ResponseMessageType, size_t CAPACITY>
+  bool RetryingServiceClient<_RequestMessageType, _ResponseMessageType, CAPACITY>::is_ready(void) const noexcept
+  {
+    return this->_is_attached;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+// Included unguarded, so that reflection of message types included since is implemented first
+#include "reflection.hpp"
+
+#ifndef RCLC_CPPB__SERIALIZATION_H_
+  #define RCLC_CPPB__SERIALIZATION_H_
+
+  #include <stdint.h>
+  #include <stddef.h>
+  #include <string.h>
+
+  #include <rcl/rcl.h>
+
+  namespace rclc_cppb
+  {
+    /**
+     * Byte order of serialized data
+    */
+    enum class Endianness: uint8_t
+    {
+      BIG = 0,
+      LITTLE = 1,
+      NATIVE =
+        #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+          BIG
+        #else
+          LITTLE
+        #endif
+    };
+
+    /**
+     * FixedLayout trait.
+     *
+     * Declares that the in-memory layout of a message type equals its CDR serialization,
+     * so that it can be serialized with a single memcpy instead of field by field.
+     * Publishers of such message types publish through this fast path.
+     *
+     * This holds for message types which are fixed-size, contain no padding and whose fields are naturally aligned.
+     * The Reflection trait must be implemented for the message type, and is used to verify the first two at compile time.
+     * The alignment is not verified, so implementing the trait is a promise that the serialized bytes equal
+     * those of the micro-ROS type-support for the message type, which should be compared once on the target.
+     *
+     * Implement with the FIXED_LAYOUT_IMPL macro.
+     * Not implemented for any message type of this library, as none has been verified that way.
+     *
+     * @param <_MessageType> The message-type for which the trait is implemented
+    */
+    template<typename _MessageType>
+    struct FixedLayout
+    {
+      /**
+       * Public export of _MessageType
+      */
+      using MessageType = _MessageType;
+
+      /**
+       * true if trait is implemented
+       *
+       * Please override this and set to true in implementation
+      */
+      constexpr static const bool IS_IMPL = false;
+      /**
+       * Size of the serialized message in bytes
+      */
+      constexpr static const size_t SERIALIZED_SIZE = 0;
+    };
+
+    namespace serialization
+    {
+      /**
+       * Serializes a fixed-layout message into a buffer, in the headerless form of the micro-ROS type-support.
+       * A single memcpy when the byte order is native, otherwise swapped field by field.
+       * @param message Message
+       * @param buffer Buffer to serialize into
+       * @param capacity Size of buffer in bytes
+       * @param endianness Byte order to serialize with
+       * @return Serialized size in bytes, or 0 if the buffer is too small
+      */
+      template<typename _MessageType>
+      size_t serialize(
+        const _MessageType& message,
+        uint8_t* buffer,
+        size_t capacity,
+        Endianness endianness = Endianness::NATIVE
+      ) noexcept;
+      /**
+       * Reverses the byte order of every scalar in a value, field by field
+       * @param value Value
+      */
+      template<typename _Type>
+      void swap_bytes(_Type& value) noexcept;
+    }
+  }
+
+  #define FIXED_LAYOUT_IMPL(MESSAGE_TYPE) \
+  template<> \
+  struct rclc_cppb::FixedLayout<MESSAGE_TYPE> \
+  { \
+    static_assert(rclc_cppb::Reflection<MESSAGE_TYPE>::IS_IMPL, "Trait Reflection must be implemented!"); \
+    static_assert(rclc_cppb::reflection::is_packed<MESSAGE_TYPE>(), "Message type must be fixed-size and without padding!"); \
+     \
+    using MessageType = MESSAGE_TYPE; \
+     \
+    constexpr static const bool IS_IMPL = true; \
+    constexpr static const size_t SERIALIZED_SIZE = sizeof(MESSAGE_TYPE); \
+  };
+
+  #include "serialization_impl.hpp"
+#endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "serialization.hpp"
+
+namespace rclc_cppb::serialization
+{
+  template<typename... _Fields, typename _Type>
+  void swap_bytes_fields(FieldList<_Fields...>, _Type& value) noexcept
+  {
+    (swap_bytes(_Fields::get_mut(value)), ...);
+  }
+
+  template<typename _Type>
+  void swap_bytes(_Type& value) noexcept
+  {
+    using Reflected = Reflect<_Type>;
+    static_assert(Reflected::IS_FIXED_SIZE, "Only fixed-size types can be byte-swapped!");
+
+    if constexpr(Reflected::KIND == FieldKind::SCALAR)
+    {
+      uint8_t* bytes = (uint8_t*)&value;
+      for(size_t i = 0; i < sizeof(_Type)/2; i++)
+      {
+        const uint8_t byte = bytes[i];
+        bytes[i] = bytes[sizeof(_Type) - 1 - i];
+        bytes[sizeof(_Type) - 1 - i] = byte;
+      }
+    }
+    else if constexpr(Reflected::KIND == FieldKind::ARRAY)
+    {
+      for(size_t i = 0; i < sizeof(_Type)/sizeof(value[0]); i++)
+      {
+        swap_bytes(value[i]);
+      }
+    }
+    else
+    {
+      swap_bytes_fields(typename Reflected::Fields(), value);
+    }
+  }
+
+  template<typename _MessageType>
+  size_t serialize(
+    const _MessageType& message,
+    uint8_t* buffer,
+    size_t capacity,
+    Endianness endianness
+  ) noexcept
+  {
+    static_assert(FixedLayout<_MessageType>::IS_IMPL, "Trait FixedLayout must be implemented!");
+    constexpr size_t SIZE = FixedLayout<_MessageType>::SERIALIZED_SIZE;
+
+    if(capacity < SIZE)
+    {
+      return 0;
+    }
+    if(endianness == Endianness::NATIVE)
+    {
+      memcpy(buffer, &message, SIZE);
+      return SIZE;
+    }
+    _MessageType swapped = message;
+    swap_bytes(swapped);
+    memcpy(buffer, &swapped, SIZE);
+    return SIZE;
+  }
+}
\ No newline at end of file
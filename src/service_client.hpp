@@ -4,6 +4,7 @@
 #include "service.hpp"
 #include "node.hpp"
 #include "handle.hpp"
+#include "coroutine.hpp"
 
 namespace rclc_cppb
 {
@@ -61,6 +62,11 @@ namespace rclc_cppb
         const ResponseMessageType* response_message
       );
 
+      /**
+       * Amount of executor handles needed by this service client
+      */
+      static constexpr unsigned int HANDLE_COUNT = 1;
+
     public:
       /**
        * Service name
@@ -68,6 +74,14 @@ namespace rclc_cppb
       const char* const service_name;
 
     private:
+      /**
+       * First service client of this type in the list, used to find the client a response belongs to
+      */
+      static ServiceClient* _first;
+      /**
+       * Next service client of this type in the list
+      */
+      ServiceClient* _next;
       /**
        * rclc client entity
       */
@@ -81,13 +95,25 @@ namespace rclc_cppb
       */
       ResponseMessageType _response_message;
       /**
-       * Given by the executor to keep track of the clients it manages
+       * Sequence number of the last request sent
+      */
+      int64_t _sequence_number = 0;
+      /**
+       * Sequence number of the request the last response belongs to
       */
-      int64_t _sequence_number;
+      int64_t _response_sequence_number = 0;
+      /**
+       * True while the response to an async_call is awaited
+      */
+      bool _is_awaiting = false;
       /**
        * Callback function used by this service client
       */
       CallbackType _callback;
+      /**
+       * Number of responses received, wrapping around
+      */
+      uint32_t _response_count = 0;
       /**
        * Stage of initialization for this service client
       */
@@ -108,11 +134,11 @@ namespace rclc_cppb
        * @param <_ResponseMessageType> Response message type handled by service client
        * @param node Pointer to node owning the service client
        * @param service_name Service name (slash and namespace of node is appended later)
-       * @param callback Pointer to callback-function used by this service client
+       * @param callback Pointer to callback-function used by this service client, or NULL if responses are only awaited
        * @param default_request_data Initial request message data
       */
       ServiceClient(
-        const Node* node,
+        Node* node,
         const char* service_name,
         CallbackType callback,
         RequestDataType default_request_data
@@ -120,6 +146,9 @@ namespace rclc_cppb
 
       ~ServiceClient() noexcept;
 
+      using Handle::set_priority;
+      using Handle::get_priority;
+
       /**
        * Initializes the service client, and then attaches to the service on the ROS2 network.
        * Node must be successfully initialized for this to succeed.
@@ -145,17 +174,54 @@ namespace rclc_cppb
 
       /**
        * Calls the service with the current request message.
-       * Service client must be successfully attached for this to succeed.
+       * Service client must be successfully attached for this to succeed,
+       * and fails while the response to an async_call is awaited.
        * @return true if success
       */
       bool call(void) noexcept;
       /**
        * Calls the service with given data in request message.
-       * Service client must be successfully attached for this to succeed.
+       * Service client must be successfully attached for this to succeed,
+       * and fails while the response to an async_call is awaited.
        * @param request_data Request message data
        * @return true if success
       */
       bool call(RequestDataType request_data) noexcept;
+
+      #ifdef RCLC_CPPB_COROUTINES
+        /**
+         * Calls the service with given data in request message, then awaits the response within a coroutine,
+         * see @see{Task}. The callback, if any, still runs first.
+         * Only one call per client may be awaited at a time, as all responses are received into the same message:
+         * until the awaitable of the previous call is destroyed, further calls resume at once with NULL.
+         * @param request_data Request message data
+         * @param timeout_ns Maximum time to wait in nanoseconds
+         * @return Awaitable resuming with a pointer to the response, valid until the next spin,
+         * or NULL if the call failed or timed out
+        */
+        ReceiveAwaitable<ResponseMessageType> async_call(
+          RequestDataType request_data,
+          uint64_t timeout_ns = ReceiveAwaitable<ResponseMessageType>::NO_TIMEOUT
+        ) noexcept;
+      #endif
+    private:
+      /**
+       * Counts a received response, then calls the callback. Called by the executor.
+       * @param response_message Received response
+       * @param request_id Id of the request the response belongs to
+      */
+      static void on_response(const void* response_message, rmw_request_id_t* request_id) noexcept;
+    protected:
+      /**
+       * Finalizes the service client after the session to the agent was lost
+       * @return true if it had been attached
+      */
+      bool on_session_lost(void) noexcept override;
+      /**
+       * Attaches the service client again after the session to the agent was restored
+       * @return true if success
+      */
+      bool on_session_restored(void) noexcept override;
   };
 }
 
@@ -3,33 +3,48 @@
 #include "service_client.hpp"
 
 #include "error.hpp"
+#include "trace.hpp"
 
 namespace rclc_cppb
 {
+  template<typename _RequestMessageType, typename _ResponseMessageType>
+  ServiceClient<_RequestMessageType, _ResponseMessageType>*
+    ServiceClient<_RequestMessageType, _ResponseMessageType>::_first = NULL;
+
   template<typename _RequestMessageType, typename _ResponseMessageType>
   ServiceClient<_RequestMessageType, _ResponseMessageType>::ServiceClient(
-    const Node* node,
+    Node* node,
     const char* service_name,
     CallbackType callback,
     RequestDataType default_request_data
   ) noexcept:
-    Handle(node, 2),
+    Handle(node, ServiceClient::HANDLE_COUNT),
     service_name(service_name),
-    _callback(callback),
-    _request_message(Message<RequestMessageType>::from_data(default_request_data))
+    _next(ServiceClient::_first),
+    _request_message(Message<RequestMessageType>::from_data(default_request_data)),
+    _callback(callback)
   {
-
+    ServiceClient::_first = this;
   }
   
   template<typename _RequestMessageType, typename _ResponseMessageType>
   ServiceClient<_RequestMessageType, _ResponseMessageType>::~ServiceClient() noexcept
   {
+    for(ServiceClient** client = &ServiceClient::_first; *client != NULL; client = &(*client)->_next)
+    {
+      if(*client == this)
+      {
+        *client = this->_next;
+        break;
+      }
+    }
+
     rclc_cppb::error::handled_call<
       decltype(&rcl_client_fini),
       &rcl_client_fini
     >(
       &this->_client,
-      this->get_node_handle()
+      this->get_node_handle_mut()
     );
   }
 
@@ -39,7 +54,7 @@ namespace rclc_cppb
     static_assert(InitStage::NEW < InitStage::INIT_DONE);
     if(this->_init_stage < InitStage::INIT_DONE)
     {
-      const String full_name = this->_node->append_namespace_to_token(this->service_name);
+      const String full_name = this->get_node()->append_namespace_to_token(this->service_name);
       // Initialize client with default configuration
       if(
         !rclc_cppb::error::handled_call<
@@ -67,23 +82,24 @@ namespace rclc_cppb
     static_assert(InitStage::INIT_DONE < InitStage::EXECUTOR_DONE);
     if(this->_init_stage < InitStage::EXECUTOR_DONE)
     {
-      // Add client callback to the executor
+      // Add client callback to the executor, with the request id so that responses can be matched to requests
       if(
         !rclc_cppb::error::handled_call<
-          decltype(&rclc_executor_add_client),
-          &rclc_executor_add_client
+          decltype(&rclc_executor_add_client_with_request_id),
+          &rclc_executor_add_client_with_request_id
         >(
           Handle::get_executor_mut(),
           &this->_client,
           &this->_response_message,
-          (rclc_client_callback_t)this->_callback
+          &ServiceClient::on_response
         )
       )
       {
         return false;
       }
       this->_init_stage = InitStage::EXECUTOR_DONE;
-      Node::spin_once();
+      this->on_executor_added(&this->_client);
+      Node::spin_once(0);
     }
     return true;
   }
@@ -111,11 +127,9 @@ namespace rclc_cppb
   template<typename _RequestMessageType, typename _ResponseMessageType>
   bool ServiceClient<_RequestMessageType, _ResponseMessageType>::call(void) noexcept
   {
-    if(this->_init_stage < InitStage::EXECUTOR_DONE)
-    {
-      return false;
-    }
     if(
+      this->_init_stage < InitStage::EXECUTOR_DONE ||
+      this->_is_awaiting ||
       !rclc_cppb::error::handled_call<
         decltype(&rcl_send_request),
         &rcl_send_request
@@ -126,9 +140,10 @@ namespace rclc_cppb
       )
     )
     {
+      Handle::count_lost_message();
       return false;
     }
-    Node::spin_once();
+    Node::spin_once(0);
     return true;
   }
   
@@ -140,4 +155,73 @@ namespace rclc_cppb
     this->set_request_data(request_data);
     return this->call();
   }
+
+  #ifdef RCLC_CPPB_COROUTINES
+    template<typename _RequestMessageType, typename _ResponseMessageType>
+    ReceiveAwaitable<_ResponseMessageType> ServiceClient<_RequestMessageType, _ResponseMessageType>::async_call(
+      RequestDataType request_data,
+      uint64_t timeout_ns
+    ) noexcept
+    {
+      // Read before calling, as the response may already arrive while calling
+      const uint32_t start_count = this->_response_count;
+      if(!this->call(request_data))
+      {
+        return ReceiveAwaitable<ResponseMessageType>(NULL, 0, NULL, timeout_ns);
+      }
+      // Another response taken before this one resumes would overwrite it, so no other call is sent meanwhile
+      this->_is_awaiting = true;
+      return ReceiveAwaitable<ResponseMessageType>(
+        &this->_response_count,
+        start_count,
+        &this->_response_message,
+        timeout_ns,
+        &this->_response_sequence_number,
+        this->_sequence_number,
+        &this->_is_awaiting
+      );
+    }
+  #endif
+
+  template<typename _RequestMessageType, typename _ResponseMessageType>
+  void ServiceClient<_RequestMessageType, _ResponseMessageType>::on_response(
+    const void* response_message,
+    rmw_request_id_t* request_id
+  ) noexcept
+  {
+    // rclc passes no context to client callbacks, so the client is found by the response memory it owns
+    for(ServiceClient* client = ServiceClient::_first; client != NULL; client = client->_next)
+    {
+      if(&client->_response_message == response_message)
+      {
+        client->_response_sequence_number = request_id->sequence_number;
+        client->_response_count++;
+        if(client->_callback != NULL)
+        {
+          RCLC_CPPB_TRACE(CALLBACK_BEGIN, client->service_name, 0);
+          client->_callback((const ResponseMessageType*)response_message);
+          RCLC_CPPB_TRACE(CALLBACK_END, client->service_name, 0);
+        }
+        return;
+      }
+    }
+  }
+
+  template<typename _RequestMessageType, typename _ResponseMessageType>
+  bool ServiceClient<_RequestMessageType, _ResponseMessageType>::on_session_lost(void) noexcept
+  {
+    if(this->_init_stage < InitStage::INIT_DONE)
+    {
+      return false;
+    }
+    this->_init_stage = InitStage::NEW;
+    // Errors are expected, as the agent is gone
+    (void)rcl_client_fini(&this->_client, this->get_node_handle_mut());
+    return true;
+  }
+  template<typename _RequestMessageType, typename _ResponseMessageType>
+  bool ServiceClient<_RequestMessageType, _ResponseMessageType>::on_session_restored(void) noexcept
+  {
+    return this->attach();
+  }
 }
\ No newline at end of file
@@ -61,6 +61,11 @@ namespace rclc_cppb
         const RequestMessageType* request_message,
         ResponseMessageType* response_message
       );
+
+      /**
+       * Amount of executor handles needed by this service server
+      */
+      static constexpr unsigned int HANDLE_COUNT = 1;
     public:
       /**
        * Service name
@@ -113,6 +118,9 @@ namespace rclc_cppb
 
       ~ServiceServer() noexcept;
 
+      using Handle::set_priority;
+      using Handle::get_priority;
+
       /**
        * Initializes the service server, and then advertises the service onto the ROS2 network.
        * Node must be successfully initialized for this to succeed.
@@ -130,6 +138,27 @@ namespace rclc_cppb
        * @return Reference to response message data
       */
       ResponseDataRef get_last_response_data(void) noexcept;
+    private:
+      #ifdef RCLC_CPPB_TRACING
+        /**
+         * Traces then calls the callback. Called by the executor.
+         * @param request_message Received request
+         * @param response_message Response to fill in
+         * @param context Pointer to the service server
+        */
+        static void on_request(const void* request_message, void* response_message, void* context) noexcept;
+      #endif
+    protected:
+      /**
+       * Finalizes the service server after the session to the agent was lost
+       * @return true if it had been advertised
+      */
+      bool on_session_lost(void) noexcept override;
+      /**
+       * Advertises the service again after the session to the agent was restored
+       * @return true if success
+      */
+      bool on_session_restored(void) noexcept override;
   };
 }
 
@@ -3,6 +3,7 @@
 #include "service_server.hpp"
 
 #include "error.hpp"
+#include "trace.hpp"
 
 namespace rclc_cppb
 {
@@ -12,7 +13,7 @@ namespace rclc_cppb
     const char* service_name,
     CallbackType callback
   ) noexcept:
-    Handle(node, 2),
+    Handle(node, ServiceServer::HANDLE_COUNT),
     service_name(service_name),
     _callback(callback)
   {
@@ -27,7 +28,7 @@ namespace rclc_cppb
       &rcl_service_fini
     >(
       &this->_service,
-      this->_node->get_handle_mut()
+      this->get_node_handle_mut()
     );
   }
 
@@ -37,7 +38,7 @@ namespace rclc_cppb
     static_assert(InitStage::NEW < InitStage::INIT_DONE);
     if(this->_init_stage < InitStage::INIT_DONE)
     {
-      const String full_name = this->_node->append_namespace_to_token(this->service_name);
+      const String full_name = this->get_node()->append_namespace_to_token(this->service_name);
       // Initialize server with default configuration
       if(
         !rclc_cppb::error::handled_call<
@@ -45,7 +46,7 @@ namespace rclc_cppb
           &rclc_service_init_default
         >(
           &this->_service,
-          this->_node->get_handle(),
+          this->get_node_handle(),
           Service<RequestMessageType, ResponseMessageType>::get_type_support(),
           full_name.c_str()
         )
@@ -65,8 +66,21 @@ namespace rclc_cppb
     static_assert(InitStage::INIT_DONE < InitStage::EXECUTOR_DONE);
     if(this->_init_stage < InitStage::EXECUTOR_DONE)
     {
-      if(
-        !rclc_cppb::error::handled_call<
+      #ifdef RCLC_CPPB_TRACING
+        // Dispatched through on_request, so that the callback is traced
+        const bool success = rclc_cppb::error::handled_call<
+          decltype(&rclc_executor_add_service_with_context),
+          &rclc_executor_add_service_with_context
+        >(
+          Handle::get_executor_mut(),
+          &this->_service,
+          &this->_request_message,
+          &this->_response_message,
+          &ServiceServer::on_request,
+          this
+        );
+      #else
+        const bool success = rclc_cppb::error::handled_call<
           decltype(&rclc_executor_add_service),
           &rclc_executor_add_service
         >(
@@ -75,19 +89,36 @@ namespace rclc_cppb
           &this->_request_message,
           &this->_response_message,
           (rclc_service_callback_t)this->_callback
-        )
-      )
+        );
+      #endif
+      if(!success)
       {
         // remove service from executor?
         return false;
       }
       this->_init_stage = InitStage::EXECUTOR_DONE;
+      this->on_executor_added(&this->_service);
       
-      Node::spin_once();
+      Node::spin_once(0);
     }
     return true;
   }
   
+  #ifdef RCLC_CPPB_TRACING
+    template<typename _RequestMessageType, typename _ResponseMessageType>
+    void ServiceServer<_RequestMessageType, _ResponseMessageType>::on_request(
+      const void* request_message,
+      void* response_message,
+      void* context
+    ) noexcept
+    {
+      ServiceServer* server = (ServiceServer*)context;
+      RCLC_CPPB_TRACE(CALLBACK_BEGIN, server->service_name, 0);
+      server->_callback((const RequestMessageType*)request_message, (ResponseMessageType*)response_message);
+      RCLC_CPPB_TRACE(CALLBACK_END, server->service_name, 0);
+    }
+  #endif
+
   template<typename _RequestMessageType, typename _ResponseMessageType>
   typename Message<_RequestMessageType>::DataRef
     ServiceServer<_RequestMessageType, _ResponseMessageType>::get_last_request_data(void) noexcept
@@ -100,4 +131,22 @@ namespace rclc_cppb
   {
     return Message<ResponseMessageType>::get_data(this->_response_message);
   }
+
+  template<typename _RequestMessageType, typename _ResponseMessageType>
+  bool ServiceServer<_RequestMessageType, _ResponseMessageType>::on_session_lost(void) noexcept
+  {
+    if(this->_init_stage < InitStage::INIT_DONE)
+    {
+      return false;
+    }
+    this->_init_stage = InitStage::NEW;
+    // Errors are expected, as the agent is gone
+    (void)rcl_service_fini(&this->_service, this->get_node_handle_mut());
+    return true;
+  }
+  template<typename _RequestMessageType, typename _ResponseMessageType>
+  bool ServiceServer<_RequestMessageType, _ResponseMessageType>::on_session_restored(void) noexcept
+  {
+    return this->advertise();
+  }
 }
\ No newline at end of file
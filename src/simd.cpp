@@ -0,0 +1,210 @@
+#include "simd.hpp"
+
+#include <math.h>
+
+#if defined(__AVX__) || defined(__AVX2__)
+  #include <immintrin.h>
+#elif defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+
+namespace rclc_cppb::simd
+{
+  static constexpr float INT16_MIN_FLOAT = -32768.0f;
+  static constexpr float INT16_MAX_FLOAT = 32767.0f;
+
+  void scale(float* data, size_t count, float factor) noexcept
+  {
+    size_t i = 0;
+    #if defined(__AVX__)
+      const __m256 factors = _mm256_set1_ps(factor);
+      for(; i + 8 <= count; i += 8)
+      {
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), factors));
+      }
+    #elif defined(__SSE2__)
+      const __m128 factors = _mm_set1_ps(factor);
+      for(; i + 4 <= count; i += 4)
+      {
+        _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), factors));
+      }
+    #endif
+    for(; i < count; i++)
+    {
+      data[i] *= factor;
+    }
+  }
+
+  void convert(const int16_t* source, float* destination, size_t count, float factor) noexcept
+  {
+    size_t i = 0;
+    #if defined(__AVX2__)
+      const __m256 factors = _mm256_set1_ps(factor);
+      for(; i + 8 <= count; i += 8)
+      {
+        const __m256i integers = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(source + i)));
+        _mm256_storeu_ps(destination + i, _mm256_mul_ps(_mm256_cvtepi32_ps(integers), factors));
+      }
+    #elif defined(__SSE2__)
+      const __m128 factors = _mm_set1_ps(factor);
+      for(; i + 8 <= count; i += 8)
+      {
+        const __m128i integers = _mm_loadu_si128((const __m128i*)(source + i));
+        // Sign-extend by placing each value in the upper half of a 32-bit lane, then shifting down
+        const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(integers, integers), 16);
+        const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(integers, integers), 16);
+        _mm_storeu_ps(destination + i, _mm_mul_ps(_mm_cvtepi32_ps(low), factors));
+        _mm_storeu_ps(destination + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), factors));
+      }
+    #endif
+    for(; i < count; i++)
+    {
+      destination[i] = (float)source[i]*factor;
+    }
+  }
+
+  void convert(const float* source, int16_t* destination, size_t count, float factor) noexcept
+  {
+    size_t i = 0;
+    #if defined(__SSE2__)
+      const __m128 factors = _mm_set1_ps(factor);
+      const __m128 lower = _mm_set1_ps(INT16_MIN_FLOAT);
+      const __m128 upper = _mm_set1_ps(INT16_MAX_FLOAT);
+      for(; i + 8 <= count; i += 8)
+      {
+        // Clamping first keeps out-of-range values from converting to the integer indefinite value
+        const __m128 low = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(source + i), factors), lower), upper);
+        const __m128 high = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(source + i + 4), factors), lower), upper);
+        const __m128i integers = _mm_packs_epi32(_mm_cvtps_epi32(low), _mm_cvtps_epi32(high));
+        _mm_storeu_si128((__m128i*)(destination + i), integers);
+      }
+    #endif
+    for(; i < count; i++)
+    {
+      float value = source[i]*factor;
+      if(!(value > INT16_MIN_FLOAT))
+      {
+        value = INT16_MIN_FLOAT;
+      }
+      else if(value > INT16_MAX_FLOAT)
+      {
+        value = INT16_MAX_FLOAT;
+      }
+      destination[i] = (int16_t)lrintf(value);
+    }
+  }
+
+  void min_max(const float* data, size_t count, float& min, float& max) noexcept
+  {
+    float lowest = data[0];
+    float highest = data[0];
+    size_t i = 0;
+    #if defined(__AVX__)
+      if(count >= 8)
+      {
+        __m256 lowests = _mm256_loadu_ps(data);
+        __m256 highests = lowests;
+        for(i = 8; i + 8 <= count; i += 8)
+        {
+          const __m256 values = _mm256_loadu_ps(data + i);
+          lowests = _mm256_min_ps(lowests, values);
+          highests = _mm256_max_ps(highests, values);
+        }
+        float lanes_low[8];
+        float lanes_high[8];
+        _mm256_storeu_ps(lanes_low, lowests);
+        _mm256_storeu_ps(lanes_high, highests);
+        for(size_t lane = 0; lane < 8; lane++)
+        {
+          lowest = lanes_low[lane] < lowest ? lanes_low[lane] : lowest;
+          highest = lanes_high[lane] > highest ? lanes_high[lane] : highest;
+        }
+      }
+    #elif defined(__SSE2__)
+      if(count >= 4)
+      {
+        __m128 lowests = _mm_loadu_ps(data);
+        __m128 highests = lowests;
+        for(i = 4; i + 4 <= count; i += 4)
+        {
+          const __m128 values = _mm_loadu_ps(data + i);
+          lowests = _mm_min_ps(lowests, values);
+          highests = _mm_max_ps(highests, values);
+        }
+        float lanes_low[4];
+        float lanes_high[4];
+        _mm_storeu_ps(lanes_low, lowests);
+        _mm_storeu_ps(lanes_high, highests);
+        for(size_t lane = 0; lane < 4; lane++)
+        {
+          lowest = lanes_low[lane] < lowest ? lanes_low[lane] : lowest;
+          highest = lanes_high[lane] > highest ? lanes_high[lane] : highest;
+        }
+      }
+    #endif
+    for(; i < count; i++)
+    {
+      lowest = data[i] < lowest ? data[i] : lowest;
+      highest = data[i] > highest ? data[i] : highest;
+    }
+    min = lowest;
+    max = highest;
+  }
+
+  void min_max(const int16_t* data, size_t count, int16_t& min, int16_t& max) noexcept
+  {
+    int16_t lowest = data[0];
+    int16_t highest = data[0];
+    size_t i = 0;
+    #if defined(__AVX2__)
+      if(count >= 16)
+      {
+        __m256i lowests = _mm256_loadu_si256((const __m256i*)data);
+        __m256i highests = lowests;
+        for(i = 16; i + 16 <= count; i += 16)
+        {
+          const __m256i values = _mm256_loadu_si256((const __m256i*)(data + i));
+          lowests = _mm256_min_epi16(lowests, values);
+          highests = _mm256_max_epi16(highests, values);
+        }
+        int16_t lanes_low[16];
+        int16_t lanes_high[16];
+        _mm256_storeu_si256((__m256i*)lanes_low, lowests);
+        _mm256_storeu_si256((__m256i*)lanes_high, highests);
+        for(size_t lane = 0; lane < 16; lane++)
+        {
+          lowest = lanes_low[lane] < lowest ? lanes_low[lane] : lowest;
+          highest = lanes_high[lane] > highest ? lanes_high[lane] : highest;
+        }
+      }
+    #elif defined(__SSE2__)
+      if(count >= 8)
+      {
+        __m128i lowests = _mm_loadu_si128((const __m128i*)data);
+        __m128i highests = lowests;
+        for(i = 8; i + 8 <= count; i += 8)
+        {
+          const __m128i values = _mm_loadu_si128((const __m128i*)(data + i));
+          lowests = _mm_min_epi16(lowests, values);
+          highests = _mm_max_epi16(highests, values);
+        }
+        int16_t lanes_low[8];
+        int16_t lanes_high[8];
+        _mm_storeu_si128((__m128i*)lanes_low, lowests);
+        _mm_storeu_si128((__m128i*)lanes_high, highests);
+        for(size_t lane = 0; lane < 8; lane++)
+        {
+          lowest = lanes_low[lane] < lowest ? lanes_low[lane] : lowest;
+          highest = lanes_high[lane] > highest ? lanes_high[lane] : highest;
+        }
+      }
+    #endif
+    for(; i < count; i++)
+    {
+      lowest = data[i] < lowest ? data[i] : lowest;
+      highest = data[i] > highest ? data[i] : highest;
+    }
+    min = lowest;
+    max = highest;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "multi_array.hpp"
+
+/**
+ * Vectorised helpers for bulk processing of sample buffers and MultiArray messages.
+ *
+ * On host builds with SSE2 or AVX available, the helpers use the matching intrinsics.
+ * Otherwise they are plain loops written so that the compiler can vectorise them,
+ * which covers MCUs with or without NEON or Helium.
+*/
+namespace rclc_cppb::simd
+{
+  /**
+   * Multiplies every value in place.
+   * @param data Pointer to values
+   * @param count Amount of values
+   * @param factor Factor to multiply with
+  */
+  void scale(float* data, size_t count, float factor) noexcept;
+
+  /**
+   * Converts integers to floats, multiplying with a factor.
+   * @param source Pointer to integers
+   * @param destination Pointer to floats
+   * @param count Amount of values
+   * @param factor Factor to multiply with, e.g. 1.0f/32768.0f to normalize
+  */
+  void convert(const int16_t* source, float* destination, size_t count, float factor = 1.0f) noexcept;
+  /**
+   * Converts floats to integers, multiplying with a factor, rounding to nearest and saturating.
+   * @param source Pointer to floats
+   * @param destination Pointer to integers
+   * @param count Amount of values
+   * @param factor Factor to multiply with, e.g. 32767.0f to denormalize
+  */
+  void convert(const float* source, int16_t* destination, size_t count, float factor = 1.0f) noexcept;
+
+  /**
+   * Finds the smallest and largest value.
+   * @param data Pointer to values
+   * @param count Amount of values, must be at least 1
+   * @param min Set to the smallest value
+   * @param max Set to the largest value
+  */
+  void min_max(const float* data, size_t count, float& min, float& max) noexcept;
+  /**
+   * Finds the smallest and largest value.
+   * @param data Pointer to values
+   * @param count Amount of values, must be at least 1
+   * @param min Set to the smallest value
+   * @param max Set to the largest value
+  */
+  void min_max(const int16_t* data, size_t count, int16_t& min, int16_t& max) noexcept;
+
+  /**
+   * Copies values into the preallocated element sequence of a MultiArray message, and sets its size.
+   * Copies no more than the capacity of the message.
+   * @param message Message with preallocated memory
+   * @param source Pointer to values
+   * @param count Amount of values
+   * @return Amount of values copied
+  */
+  template<typename _ElementType>
+  size_t copy_into(
+    typename MultiArray<_ElementType>::MessageType& message,
+    const _ElementType* source,
+    size_t count
+  ) noexcept;
+  /**
+   * Converts values into the preallocated element sequence of a MultiArray message, and sets its size.
+   * Converts no more than the capacity of the message.
+   * @param message Message with preallocated memory
+   * @param source Pointer to values
+   * @param count Amount of values
+   * @param factor Factor to multiply with
+   * @return Amount of values converted
+  */
+  template<typename _ElementType, typename _SourceType>
+  size_t convert_into(
+    typename MultiArray<_ElementType>::MessageType& message,
+    const _SourceType* source,
+    size_t count,
+    float factor = 1.0f
+  ) noexcept;
+  /**
+   * Finds the smallest and largest element of a MultiArray message, e.g. one from @code{Subscriber::get_last_data()}.
+   * @param message Message
+   * @param min Set to the smallest element
+   * @param max Set to the largest element
+   * @return false if the message has no elements
+  */
+  template<typename _ElementType>
+  bool min_max(
+    const typename MultiArray<_ElementType>::MessageType& message,
+    _ElementType& min,
+    _ElementType& max
+  ) noexcept;
+}
+
+#include "simd_impl.hpp"
\ No newline at end of file
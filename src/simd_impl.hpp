@@ -0,0 +1,59 @@
+#pragma once
+
+#include "simd.hpp"
+
+#include <string.h>
+
+namespace rclc_cppb::simd
+{
+  template<typename _ElementType>
+  size_t copy_into(
+    typename MultiArray<_ElementType>::MessageType& message,
+    const _ElementType* source,
+    size_t count
+  ) noexcept
+  {
+    const size_t capacity = MultiArray<_ElementType>::get_capacity(message);
+    if(count > capacity)
+    {
+      count = capacity;
+    }
+    memcpy(MultiArray<_ElementType>::get_elements(message), source, count*sizeof(_ElementType));
+    MultiArray<_ElementType>::set_size(message, count);
+    return count;
+  }
+
+  template<typename _ElementType, typename _SourceType>
+  size_t convert_into(
+    typename MultiArray<_ElementType>::MessageType& message,
+    const _SourceType* source,
+    size_t count,
+    float factor
+  ) noexcept
+  {
+    const size_t capacity = MultiArray<_ElementType>::get_capacity(message);
+    if(count > capacity)
+    {
+      count = capacity;
+    }
+    convert(source, MultiArray<_ElementType>::get_elements(message), count, factor);
+    MultiArray<_ElementType>::set_size(message, count);
+    return count;
+  }
+
+  template<typename _ElementType>
+  bool min_max(
+    const typename MultiArray<_ElementType>::MessageType& message,
+    _ElementType& min,
+    _ElementType& max
+  ) noexcept
+  {
+    const size_t size = MultiArray<_ElementType>::get_size(message);
+    if(size == 0)
+    {
+      return false;
+    }
+    min_max(MultiArray<_ElementType>::get_elements(message), size, min, max);
+    return true;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "spin_hook.hpp"
+
+namespace rclc_cppb
+{
+  SpinHook* SpinHook::_first = NULL;
+  bool SpinHook::_is_running = false;
+
+  SpinHook::SpinHook(void) noexcept:
+    _next(SpinHook::_first)
+  {
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    SpinHook::_first = this;
+  }
+
+  SpinHook::~SpinHook() noexcept
+  {
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    for(SpinHook** hook = &SpinHook::_first; *hook != NULL; hook = &(*hook)->_next)
+    {
+      if(*hook == this)
+      {
+        *hook = this->_next;
+        break;
+      }
+    }
+  }
+
+  void SpinHook::run_all(void) noexcept
+  {
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    if(SpinHook::_is_running)
+    {
+      return;
+    }
+    SpinHook::_is_running = true;
+    // The next hook is taken first, as a hook may be destroyed by its own work, e.g. a resumed coroutine
+    SpinHook* next = NULL;
+    for(SpinHook* hook = SpinHook::_first; hook != NULL; hook = next)
+    {
+      next = hook->_next;
+      hook->on_spin();
+    }
+    SpinHook::_is_running = false;
+  }
+
+  uint64_t SpinHook::get_time_until_due_ns(void) const noexcept
+  {
+    return SpinHook::NEVER_DUE;
+  }
+
+  uint64_t SpinHook::get_time_until_next_due_ns(void) noexcept
+  {
+    threading::RecursiveLock lock(threading::get_spin_mutex());
+    uint64_t next_due_ns = SpinHook::NEVER_DUE;
+    for(const SpinHook* hook = SpinHook::_first; hook != NULL; hook = hook->_next)
+    {
+      const uint64_t due_ns = hook->get_time_until_due_ns();
+      if(due_ns < next_due_ns)
+      {
+        next_due_ns = due_ns;
+      }
+    }
+    return next_due_ns;
+  }
+}
\ No newline at end of file
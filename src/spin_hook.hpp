@@ -0,0 +1,70 @@
+#pragma once
+
+#include "node.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * An object which is given the chance to do work on every spin, after the executor has spun.
+   * Spin hooks can tell when their work is due, so that adaptive spins do not wait past it.
+   *
+   * All spin hooks are kept in an intrusive list, so no heap allocation takes place.
+   * Spin hooks are not run recursively: work done from within a hook which spins again
+   * (e.g. publishing) does not run the hooks a second time.
+  */
+  class SpinHook
+  {
+    public:
+      /**
+       * Time until due of a spin hook which has no work scheduled
+      */
+      static constexpr uint64_t NEVER_DUE = UINT64_MAX;
+    private:
+      /**
+       * First spin hook in the list
+      */
+      static SpinHook* _first;
+      /**
+       * true while the spin hooks are running
+      */
+      static bool _is_running;
+      /**
+       * Next spin hook in the list
+      */
+      SpinHook* _next;
+
+    protected:
+      /**
+       * An object which is given the chance to do work on every spin.
+       * Adds itself to the list of spin hooks.
+      */
+      SpinHook(void) noexcept;
+      /**
+       * Removes itself from the list of spin hooks
+      */
+      ~SpinHook() noexcept;
+
+      /**
+       * Called on every spin, after the executor has spun.
+      */
+      virtual void on_spin(void) noexcept = 0;
+      /**
+       * Returns the time until this spin hook has work due, which bounds the timeout of adaptive spins.
+       * Returns @see{NEVER_DUE} unless overrided.
+       * @return Time in nanoseconds, zero if work is due already
+      */
+      virtual uint64_t get_time_until_due_ns(void) const noexcept;
+    private:
+      /**
+       * Runs all spin hooks, unless they are running already
+      */
+      static void run_all(void) noexcept;
+      /**
+       * Returns the earliest time until any spin hook has work due
+       * @return Time in nanoseconds
+      */
+      static uint64_t get_time_until_next_due_ns(void) noexcept;
+
+      friend class Node;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "static_arena.hpp"
+
+#include <string.h>
+
+namespace rclc_cppb::static_arena
+{
+  /**
+   * Bookkeeping at the start of an arena
+  */
+  struct Control
+  {
+    size_t size;
+    size_t used;
+    size_t peak;
+  };
+  /**
+   * Header in front of every block, followed by the block payload
+  */
+  struct Block
+  {
+    size_t size;
+    size_t is_free;
+  };
+
+  static constexpr size_t round_up(size_t size) noexcept
+  {
+    return (size + ALIGNMENT - 1)/ALIGNMENT*ALIGNMENT;
+  }
+
+  static Control* get_control(void* storage) noexcept
+  {
+    return (Control*)storage;
+  }
+  static Block* get_first_block(void* storage) noexcept
+  {
+    return (Block*)((uint8_t*)storage + CONTROL_SIZE);
+  }
+  static bool is_before_end(void* storage, const Block* block) noexcept
+  {
+    return (const uint8_t*)block < (uint8_t*)storage + get_control(storage)->size;
+  }
+  static Block* get_next_block(Block* block) noexcept
+  {
+    return (Block*)((uint8_t*)block + BLOCK_HEADER_SIZE + block->size);
+  }
+
+  static void* allocate(size_t size, void* state) noexcept
+  {
+    Control* control = get_control(state);
+    size = round_up(size > 0 ? size : 1);
+    for(Block* block = get_first_block(state); is_before_end(state, block); block = get_next_block(block))
+    {
+      if(!block->is_free || block->size < size)
+      {
+        continue;
+      }
+      // Splits off the rest, unless it would be too small to ever hold anything
+      if(block->size >= size + BLOCK_HEADER_SIZE + ALIGNMENT)
+      {
+        Block* rest = (Block*)((uint8_t*)block + BLOCK_HEADER_SIZE + size);
+        rest->size = block->size - size - BLOCK_HEADER_SIZE;
+        rest->is_free = 1;
+        block->size = size;
+      }
+      block->is_free = 0;
+      control->used += BLOCK_HEADER_SIZE + block->size;
+      if(control->used > control->peak)
+      {
+        control->peak = control->used;
+      }
+      return (uint8_t*)block + BLOCK_HEADER_SIZE;
+    }
+    return NULL;
+  }
+
+  static void deallocate(void* pointer, void* state) noexcept
+  {
+    if(pointer == NULL)
+    {
+      return;
+    }
+    Block* freed = (Block*)((uint8_t*)pointer - BLOCK_HEADER_SIZE);
+    freed->is_free = 1;
+    get_control(state)->used -= BLOCK_HEADER_SIZE + freed->size;
+
+    for(Block* block = get_first_block(state); is_before_end(state, block); block = get_next_block(block))
+    {
+      if(!block->is_free)
+      {
+        continue;
+      }
+      Block* next = get_next_block(block);
+      while(is_before_end(state, next) && next->is_free)
+      {
+        block->size += BLOCK_HEADER_SIZE + next->size;
+        next = get_next_block(block);
+      }
+    }
+  }
+
+  static void* reallocate(void* pointer, size_t size, void* state) noexcept
+  {
+    if(pointer == NULL)
+    {
+      return allocate(size, state);
+    }
+    const Block* block = (const Block*)((uint8_t*)pointer - BLOCK_HEADER_SIZE);
+    if(block->size >= size)
+    {
+      return pointer;
+    }
+    void* moved = allocate(size, state);
+    if(moved == NULL)
+    {
+      return NULL;
+    }
+    memcpy(moved, pointer, block->size);
+    deallocate(pointer, state);
+    return moved;
+  }
+
+  static void* zero_allocate(size_t count, size_t size, void* state) noexcept
+  {
+    // Fails like calloc would, rather than returning a buffer smaller than count*size
+    if(size != 0 && count > SIZE_MAX/size)
+    {
+      return NULL;
+    }
+    void* pointer = allocate(count*size, state);
+    if(pointer != NULL)
+    {
+      memset(pointer, 0, count*size);
+    }
+    return pointer;
+  }
+
+  void init(uint8_t* storage, size_t size) noexcept
+  {
+    Control* control = get_control(storage);
+    control->size = size/ALIGNMENT*ALIGNMENT;
+    control->used = 0;
+    control->peak = 0;
+
+    Block* block = get_first_block(storage);
+    block->size = control->size - CONTROL_SIZE - BLOCK_HEADER_SIZE;
+    block->is_free = 1;
+  }
+
+  rcl_allocator_t get_allocator(uint8_t* storage) noexcept
+  {
+    rcl_allocator_t allocator = rcl_allocator_t();
+    allocator.allocate = &allocate;
+    allocator.deallocate = &deallocate;
+    allocator.reallocate = &reallocate;
+    allocator.zero_allocate = &zero_allocate;
+    allocator.state = storage;
+    return allocator;
+  }
+
+  size_t get_used_size(const uint8_t* storage) noexcept
+  {
+    return ((const Control*)storage)->used;
+  }
+  size_t get_peak_size(const uint8_t* storage) noexcept
+  {
+    return ((const Control*)storage)->peak;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <rcl/rcl.h>
+
+namespace rclc_cppb
+{
+  namespace static_arena
+  {
+    /**
+     * Alignment of every allocation
+    */
+    static constexpr size_t ALIGNMENT = alignof(max_align_t);
+    /**
+     * Size of the bookkeeping at the start of an arena
+    */
+    static constexpr size_t CONTROL_SIZE = (3*sizeof(size_t) + ALIGNMENT - 1)/ALIGNMENT*ALIGNMENT;
+    /**
+     * Size of the header in front of every allocation
+    */
+    static constexpr size_t BLOCK_HEADER_SIZE = (2*sizeof(size_t) + ALIGNMENT - 1)/ALIGNMENT*ALIGNMENT;
+
+    /**
+     * Computes the arena size needed to hold a number of allocations at once
+     * @param block_count Maximum amount of allocations alive at once
+     * @param payload_size Total size of those allocations in bytes
+     * @return Arena size in bytes
+    */
+    constexpr size_t get_required_size(size_t block_count, size_t payload_size) noexcept
+    {
+      return CONTROL_SIZE + block_count*(BLOCK_HEADER_SIZE + ALIGNMENT) + payload_size;
+    }
+
+    /**
+     * Initializes an arena as one free block
+     * @param storage Arena memory, aligned to @see{ALIGNMENT}
+     * @param size Size of arena memory in bytes
+    */
+    void init(uint8_t* storage, size_t size) noexcept;
+    /**
+     * Retrieves an rcl allocator which allocates from an arena
+     * @param storage Initialized arena memory
+     * @return rcl allocator
+    */
+    rcl_allocator_t get_allocator(uint8_t* storage) noexcept;
+    /**
+     * Retrieves the amount of bytes allocated from an arena, including headers
+     * @param storage Initialized arena memory
+     * @return Size in bytes
+    */
+    size_t get_used_size(const uint8_t* storage) noexcept;
+    /**
+     * Retrieves the largest amount of bytes ever allocated at once from an arena, including headers
+     * @param storage Initialized arena memory
+     * @return Size in bytes
+    */
+    size_t get_peak_size(const uint8_t* storage) noexcept;
+  }
+
+  /**
+   * Statically allocated memory which rcl can allocate from instead of the heap.
+   *
+   * Allocations are first-fit with neighbouring free blocks merged, which suits the
+   * few long-lived allocations of an executor and its wait set being rebuilt.
+   * An allocation which does not fit fails like an exhausted heap would.
+   *
+   * Usage instructions:
+   * - Instantiate globally, so that its memory is static.
+   * - Pass @see{get_allocator} to rcl, e.g. through @see{EntityGraph::use}.
+   * @param <SIZE> Size of memory in bytes
+  */
+  template<size_t SIZE>
+  class StaticArena
+  {
+    static_assert(SIZE > static_arena::CONTROL_SIZE + static_arena::BLOCK_HEADER_SIZE, "Arena is too small for a single allocation!");
+
+    private:
+      /**
+       * Arena memory
+      */
+      alignas(static_arena::ALIGNMENT) uint8_t _storage[SIZE];
+
+    public:
+      /**
+       * Statically allocated memory which rcl can allocate from instead of the heap.
+       * @param <SIZE> Size of memory in bytes
+      */
+      StaticArena(void) noexcept;
+
+      /**
+       * Retrieves an rcl allocator which allocates from this arena
+       * @return rcl allocator
+      */
+      rcl_allocator_t get_allocator(void) noexcept;
+      /**
+       * Retrieves the amount of bytes allocated, including headers
+       * @return Size in bytes
+      */
+      size_t get_used_size(void) const noexcept;
+      /**
+       * Retrieves the largest amount of bytes ever allocated at once, including headers
+       * @return Size in bytes
+      */
+      size_t get_peak_size(void) const noexcept;
+  };
+}
+
+#include "static_arena_impl.hpp"
\ No newline at end of file
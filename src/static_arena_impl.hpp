@@ -0,0 +1,28 @@
+#pragma once
+
+#include "static_arena.hpp"
+
+namespace rclc_cppb
+{
+  template<size_t SIZE>
+  StaticArena<SIZE>::StaticArena(void) noexcept
+  {
+    static_arena::init(this->_storage, SIZE);
+  }
+
+  template<size_t SIZE>
+  rcl_allocator_t StaticArena<SIZE>::get_allocator(void) noexcept
+  {
+    return static_arena::get_allocator(this->_storage);
+  }
+  template<size_t SIZE>
+  size_t StaticArena<SIZE>::get_used_size(void) const noexcept
+  {
+    return static_arena::get_used_size(this->_storage);
+  }
+  template<size_t SIZE>
+  size_t StaticArena<SIZE>::get_peak_size(void) const noexcept
+  {
+    return static_arena::get_peak_size(this->_storage);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "statistics_publisher.hpp"
+
+#include <stdio.h>
+
+#include <Arduino.h>
+
+namespace rclc_cppb
+{
+  StatisticsPublisher::StatisticsPublisher(
+    Node* node,
+    const char* topic_name,
+    uint64_t period_ns
+  ) noexcept:
+    node(node),
+    _publisher(node, topic_name, ""),
+    _period_ns(period_ns),
+    _last_publish_us(micros())
+  {
+    
+  }
+
+  bool StatisticsPublisher::advertise(void) noexcept
+  {
+    this->_is_advertised = this->_publisher.advertise();
+    return this->_is_advertised;
+  }
+
+  bool StatisticsPublisher::publish(void) noexcept
+  {
+    this->_last_publish_us = micros();
+
+    size_t length = 0;
+    this->_buffer[0] = '\0';
+    for(TopicStatistics* statistics = TopicStatistics::get_first(); statistics != NULL; statistics = statistics->get_next())
+    {
+      if(statistics->node != this->node || statistics->get_topic_name() == NULL)
+      {
+        continue;
+      }
+      const TopicStats stats = statistics->get_stats();
+      statistics->reset();
+
+      // Integer formatting, as printf of floats is left out of most embedded C libraries
+      const unsigned long rate_centi_hz = (unsigned long)(stats.rate_hz*100.0f);
+      const int line_length = snprintf(
+        this->_buffer + length,
+        sizeof(this->_buffer) - length,
+        "%s rate=%lu.%02luHz bw=%luB/s period=%lu/%lu/%luus jitter=%luus\n",
+        statistics->get_topic_name(),
+        rate_centi_hz/100,
+        rate_centi_hz%100,
+        (unsigned long)stats.bandwidth_bps,
+        stats.min_period_us,
+        stats.avg_period_us,
+        stats.max_period_us,
+        stats.jitter_us
+      );
+      if(line_length < 0 || (size_t)line_length >= sizeof(this->_buffer) - length)
+      {
+        // Does not fit, so the truncated line is cut off
+        this->_buffer[length] = '\0';
+        continue;
+      }
+      length += (size_t)line_length;
+    }
+    return this->_publisher.publish(this->_buffer);
+  }
+
+  void StatisticsPublisher::on_spin(void) noexcept
+  {
+    if(!this->_is_advertised || this->get_time_until_due_ns() > 0)
+    {
+      return;
+    }
+    this->publish();
+  }
+
+  uint64_t StatisticsPublisher::get_time_until_due_ns(void) const noexcept
+  {
+    if(!this->_is_advertised)
+    {
+      return SpinHook::NEVER_DUE;
+    }
+    const uint64_t elapsed_ns = RCL_US_TO_NS((uint64_t)(micros() - this->_last_publish_us));
+    return elapsed_ns < this->_period_ns ? this->_period_ns - elapsed_ns : 0;
+  }
+}
\ No newline at end of file
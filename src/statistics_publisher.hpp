@@ -0,0 +1,109 @@
+#pragma once
+
+#include <micro_ros_arduino.h>
+#include <rcl/rcl.h>
+#include <rcl/error_handling.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+
+#include "message.hpp"
+#include "node.hpp"
+#include "publisher.hpp"
+#include "spin_hook.hpp"
+#include "topic_statistics.hpp"
+
+/**
+ * Size in bytes of the text buffer of a statistics publisher.
+ * Lines which do not fit are left out of the message.
+*/
+#ifndef RCLC_CPPB_STATISTICS_BUFFER_SIZE
+  #define RCLC_CPPB_STATISTICS_BUFFER_SIZE 512
+#endif
+
+namespace rclc_cppb
+{
+  /**
+   * Publisher which periodically publishes the statistics of all tracked entities of a node, see @see{TopicStatistics},
+   * as a std_msgs/String with one line per entity, then starts a new window for each of them.
+   *
+   * Each line reads: topic rate=10.00Hz bw=40B/s period=99/100/101us jitter=1us
+   *
+   * Usage instructions:
+   * - Instantiate before any node is setup.
+   * - Call advertise() in on_setup-method of node or after node setup is completed.
+   * - Spin the node as usual, which publishes whenever the period has elapsed.
+  */
+  class StatisticsPublisher: SpinHook
+  {
+    public:
+      /**
+       * Default period in nanoseconds
+      */
+      static constexpr uint64_t DEFAULT_PERIOD_NS = RCL_MS_TO_NS(1000);
+
+      /**
+       * Amount of executor handles needed by this publisher
+      */
+      static constexpr unsigned int HANDLE_COUNT = Publisher<std_msgs__msg__String>::HANDLE_COUNT;
+    public:
+      /**
+       * Node whose entities are summarised
+      */
+      Node* const node;
+    private:
+      /**
+       * Publisher of the summary
+      */
+      Publisher<std_msgs__msg__String> _publisher;
+      /**
+       * Period in nanoseconds
+      */
+      const uint64_t _period_ns;
+      /**
+       * Time of the last publish, in microseconds
+      */
+      unsigned long _last_publish_us;
+      /**
+       * true if publisher has been successfully advertised
+      */
+      bool _is_advertised = false;
+      /**
+       * Text buffer of the summary
+      */
+      char _buffer[RCLC_CPPB_STATISTICS_BUFFER_SIZE];
+
+    public:
+      /**
+       * Publisher which periodically publishes the statistics of all tracked entities of a node.
+       * @param node Pointer to node whose entities are summarised, and which owns the publisher
+       * @param topic_name Topic name (slash and namespace of node is appended later)
+       * @param period_ns Period in nanoseconds
+      */
+      StatisticsPublisher(
+        Node* node,
+        const char* topic_name = "statistics",
+        uint64_t period_ns = StatisticsPublisher::DEFAULT_PERIOD_NS
+      ) noexcept;
+
+      /**
+       * Initializes the publisher, and then advertises the topic onto the ROS2 network.
+       * Node must be successfully initialized for this to succeed.
+       * @return true if success
+      */
+      bool advertise(void) noexcept;
+      /**
+       * Publishes the summary right away, then starts a new window for each tracked entity
+       * @return true if success
+      */
+      bool publish(void) noexcept;
+    protected:
+      /**
+       * Publishes the summary once the period has elapsed
+      */
+      void on_spin(void) noexcept override;
+      /**
+       * Returns the time until the period has elapsed
+      */
+      uint64_t get_time_until_due_ns(void) const noexcept override;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "stream_publisher.hpp"
+
+#include <string.h>
+
+namespace rclc_cppb
+{
+  StreamPublisher::StreamPublisher(
+    Node* node,
+    const char* topic_name,
+    size_t chunk_size,
+    size_t chunks_per_step
+  ) noexcept:
+    chunk_size(chunk_size > 0 ? chunk_size : 1),
+    chunks_per_step(chunks_per_step > 0 ? chunks_per_step : 1),
+    _publisher(node, topic_name, MessageType()),
+    _message(),
+    _dimension()
+  {
+    this->_dimension.label.data = (char*)DIMENSION_LABEL;
+    this->_dimension.label.size = strlen(DIMENSION_LABEL);
+    this->_dimension.label.capacity = this->_dimension.label.size + 1;
+
+    this->_message.layout.dim.data = &this->_dimension;
+    this->_message.layout.dim.size = 1;
+    this->_message.layout.dim.capacity = 1;
+  }
+
+  bool StreamPublisher::advertise(void) noexcept
+  {
+    return this->_publisher.advertise();
+  }
+
+  bool StreamPublisher::start(const uint8_t* payload, size_t size) noexcept
+  {
+    if(this->is_busy() || payload == NULL || size == 0)
+    {
+      return false;
+    }
+    this->_payload = payload;
+    this->_payload_size = size;
+    this->_offset = 0;
+    this->_transfer_id++;
+
+    this->_dimension.size = size;
+    this->_dimension.stride = this->_transfer_id;
+    return true;
+  }
+
+  bool StreamPublisher::step(void) noexcept
+  {
+    for(size_t i = 0; i < this->chunks_per_step && this->is_busy(); i++)
+    {
+      const size_t remaining = this->_payload_size - this->_offset;
+      const size_t length = remaining < this->chunk_size ? remaining : this->chunk_size;
+      if(length == 0)
+      {
+        // No progress possible, so fail rather than letting write() loop forever
+        return false;
+      }
+
+      // The chunk is published straight from the payload, the type-support never writes through it
+      this->_message.data.data = (uint8_t*)this->_payload + this->_offset;
+      this->_message.data.size = length;
+      this->_message.data.capacity = length;
+      this->_message.layout.data_offset = this->_offset;
+
+      if(!this->_publisher.publish(this->_message))
+      {
+        return false;
+      }
+      this->_offset += length;
+      if(this->_offset == this->_payload_size)
+      {
+        this->_payload = NULL;
+      }
+    }
+    return true;
+  }
+
+  bool StreamPublisher::write(const uint8_t* payload, size_t size) noexcept
+  {
+    if(!this->start(payload, size))
+    {
+      return false;
+    }
+    while(this->is_busy())
+    {
+      if(!this->step())
+      {
+        this->cancel();
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void StreamPublisher::cancel(void) noexcept
+  {
+    this->_payload = NULL;
+  }
+
+  bool StreamPublisher::is_busy(void) const noexcept
+  {
+    return this->_payload != NULL;
+  }
+  size_t StreamPublisher::get_progress(void) const noexcept
+  {
+    return this->_offset;
+  }
+}
\ No newline at end of file
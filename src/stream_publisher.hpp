@@ -0,0 +1,160 @@
+#pragma once
+
+#include <micro_ros_arduino.h>
+#include <rcl/rcl.h>
+#include <rcl/error_handling.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+
+#include <std_msgs/msg/u_int8_multi_array.h>
+
+#include "message.hpp"
+#include "node.hpp"
+#include "publisher.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Publisher which splits a payload larger than the transport MTU into chunks, each carried in a UInt8MultiArray message.
+   *
+   * Each chunk describes its place in the payload in the message layout:
+   * - data_offset holds the byte offset of the chunk within the payload
+   * - dim[0].size holds the total size of the payload in bytes
+   * - dim[0].stride holds the id of the transfer, which increments with every payload
+   *
+   * The chunks point directly into the payload, so no copy takes place,
+   * but the payload must stay valid and unchanged until the transfer is complete.
+   * At most chunks_per_step chunks are published per step, so that other entities get to spin in between.
+   * There is no flow control: the subscriber sends no acknowledgements or credits back,
+   * so a payload published faster than the agent drains it still overruns the history of the reliable XRCE stream,
+   * and the failing chunk is then retried on the next step. Pace the steps to the link, or keep chunks_per_step low.
+   *
+   * Usage instructions:
+   * - Instantiate before any node is setup.
+   * - Call advertise() in on_setup-method of node or after node setup is completed.
+   * - Either call write() to publish a payload at once,
+   *   or call start() and then step() every loop cycle until is_busy() returns false.
+   * - Receive the payloads with @see{StreamSubscriber}.
+  */
+  class StreamPublisher
+  {
+    public:
+      /**
+       * Message type carrying the chunks
+      */
+      using MessageType = std_msgs__msg__UInt8MultiArray;
+
+      /**
+       * Amount of executor handles needed by this publisher
+      */
+      static constexpr unsigned int HANDLE_COUNT = Publisher<MessageType>::HANDLE_COUNT;
+
+      /**
+       * Label of the single dimension in the layout of each message
+      */
+      static constexpr const char* const DIMENSION_LABEL = "stream";
+    public:
+      /**
+       * Maximum size of a chunk in bytes, at least one
+      */
+      const size_t chunk_size;
+      /**
+       * Maximum amount of chunks published per step, at least one
+      */
+      const size_t chunks_per_step;
+    private:
+      /**
+       * Publisher of the chunks
+      */
+      Publisher<MessageType> _publisher;
+      /**
+       * Chunk message, pointing into the payload
+      */
+      MessageType _message;
+      /**
+       * Preallocated layout dimension
+      */
+      std_msgs__msg__MultiArrayDimension _dimension;
+      /**
+       * Payload of current transfer, or NULL if there is none
+      */
+      const uint8_t* _payload = NULL;
+      /**
+       * Size of the payload of current transfer in bytes
+      */
+      size_t _payload_size = 0;
+      /**
+       * Amount of bytes of current transfer published so far
+      */
+      size_t _offset = 0;
+      /**
+       * Id of current transfer
+      */
+      uint32_t _transfer_id = 0;
+
+    public:
+      /**
+       * Publisher which splits a payload larger than the transport MTU into chunks.
+       *
+       * Usage instructions:
+       * - Instantiate before any node is setup.
+       * - Call advertise() in on_setup-method of node or after node setup is completed.
+       * - Call write(), or start() followed by step() every loop cycle.
+       * @param node Pointer to node owning the publisher
+       * @param topic_name Topic name (slash and namespace of node is appended later)
+       * @param chunk_size Maximum size of a chunk in bytes, which must fit the micro-ROS stream buffer along with the layout, clamped to at least one
+       * @param chunks_per_step Maximum amount of chunks published per step, clamped to at least one
+      */
+      StreamPublisher(
+        Node* node,
+        const char* topic_name,
+        size_t chunk_size,
+        size_t chunks_per_step = 1
+      ) noexcept;
+
+      /**
+       * Initializes the publisher, and then advertises the topic onto the ROS2 network.
+       * Node must be successfully initialized for this to succeed.
+       * @return true if success
+      */
+      bool advertise(void) noexcept;
+
+      /**
+       * Starts a new transfer of a payload.
+       * The payload must stay valid and unchanged until the transfer is complete.
+       * @param payload Pointer to payload
+       * @param size Size of payload in bytes, must be at least one
+       * @return false if another transfer is still in progress
+      */
+      bool start(const uint8_t* payload, size_t size) noexcept;
+      /**
+       * Publishes up to chunks_per_step chunks of the current transfer.
+       * A chunk which fails to publish is retried on the next step.
+       * @return false if a chunk failed to publish or no progress is possible
+      */
+      bool step(void) noexcept;
+      /**
+       * Publishes a whole payload, stepping until the transfer is complete.
+       * The transfer is cancelled if a chunk fails to publish.
+       * @param payload Pointer to payload
+       * @param size Size of payload in bytes, must be at least one
+       * @return true if success
+      */
+      bool write(const uint8_t* payload, size_t size) noexcept;
+      /**
+       * Cancels the current transfer.
+       * The subscriber drops the incomplete payload once the next transfer begins.
+      */
+      void cancel(void) noexcept;
+
+      /**
+       * Returns true if a transfer is in progress
+      */
+      bool is_busy(void) const noexcept;
+      /**
+       * Retrieves the amount of bytes of the current transfer published so far
+       * @return Amount of bytes
+      */
+      size_t get_progress(void) const noexcept;
+  };
+}
\ No newline at end of file
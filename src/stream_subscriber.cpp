@@ -0,0 +1,130 @@
+#include "stream_subscriber.hpp"
+
+#include <string.h>
+
+namespace rclc_cppb
+{
+  StreamSubscriber::StreamSubscriber(
+    Node* node,
+    const char* topic_name,
+    uint8_t* buffer,
+    size_t capacity,
+    CallbackType callback
+  ) noexcept:
+    _subscriber(node, topic_name, &StreamSubscriber::on_chunk, this),
+    _callback(callback),
+    _buffer(buffer),
+    _capacity(capacity),
+    _dimension()
+  {
+    this->_dimension.label.data = this->_dimension_label;
+    this->_dimension.label.size = 0;
+    this->_dimension.label.capacity = DIMENSION_LABEL_CAPACITY;
+
+    this->prepare_next();
+  }
+
+  bool StreamSubscriber::subscribe(rclc_executor_handle_invocation_t invocation) noexcept
+  {
+    return this->_subscriber.subscribe(invocation);
+  }
+
+  void StreamSubscriber::set_priority(Priority priority) noexcept
+  {
+    this->_subscriber.set_priority(priority);
+  }
+
+  bool StreamSubscriber::is_receiving(void) const noexcept
+  {
+    return this->_is_receiving;
+  }
+  uint32_t StreamSubscriber::get_dropped_count(void) const noexcept
+  {
+    return this->_dropped_count;
+  }
+
+  void StreamSubscriber::on_chunk(const MessageType* message, void* context) noexcept
+  {
+    ((StreamSubscriber*)context)->receive(*message);
+  }
+
+  void StreamSubscriber::receive(const MessageType& message) noexcept
+  {
+    if(message.layout.dim.size == 0)
+    {
+      this->drop();
+      this->prepare_next();
+      return;
+    }
+    const size_t offset = message.layout.data_offset;
+    const size_t size = message.layout.dim.data[0].size;
+    const uint32_t transfer_id = message.layout.dim.data[0].stride;
+    const size_t length = message.data.size;
+
+    if(offset == 0)
+    {
+      // A new transfer supersedes an incomplete one
+      this->drop();
+      if(size > this->_capacity)
+      {
+        this->_dropped_count++;
+        this->prepare_next();
+        return;
+      }
+      this->_is_receiving = true;
+      this->_transfer_id = transfer_id;
+      this->_transfer_size = size;
+      this->_received = 0;
+    }
+    else if(!this->_is_receiving || transfer_id != this->_transfer_id || offset != this->_received)
+    {
+      this->drop();
+      this->prepare_next();
+      return;
+    }
+    if(length > this->_transfer_size - this->_received)
+    {
+      this->drop();
+      this->prepare_next();
+      return;
+    }
+
+    // Chunks in order are received in place already, only a restarted transfer needs moving
+    uint8_t* const destination = this->_buffer + this->_received;
+    if(message.data.data != destination)
+    {
+      memmove(destination, message.data.data, length);
+    }
+    this->_received += length;
+
+    if(this->_received == this->_transfer_size)
+    {
+      this->_is_receiving = false;
+      this->_callback(this->_buffer, this->_transfer_size);
+    }
+    this->prepare_next();
+  }
+
+  void StreamSubscriber::drop(void) noexcept
+  {
+    if(this->_is_receiving)
+    {
+      this->_is_receiving = false;
+      this->_dropped_count++;
+    }
+  }
+
+  void StreamSubscriber::prepare_next(void) noexcept
+  {
+    const size_t offset = this->_is_receiving ? this->_received : 0;
+
+    MessageType message = MessageType();
+    message.data.data = this->_buffer + offset;
+    message.data.size = 0;
+    message.data.capacity = this->_capacity - offset;
+    message.layout.dim.data = &this->_dimension;
+    message.layout.dim.size = 0;
+    message.layout.dim.capacity = 1;
+    this->_subscriber.set_data(message);
+  }
+}
\ No newline at end of file
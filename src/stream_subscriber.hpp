@@ -0,0 +1,165 @@
+#pragma once
+
+#include <micro_ros_arduino.h>
+#include <rcl/rcl.h>
+#include <rcl/error_handling.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+
+#include <std_msgs/msg/u_int8_multi_array.h>
+
+#include "message.hpp"
+#include "node.hpp"
+#include "subscriber.hpp"
+
+namespace rclc_cppb
+{
+  /**
+   * Subscriber reassembling the payloads published in chunks by a @see{StreamPublisher}.
+   *
+   * Payloads are reassembled in place within a preallocated buffer.
+   * Each chunk is received directly at its expected place in the buffer,
+   * so chunks arriving in order are never copied.
+   * A transfer is dropped if a chunk is missing, or if its payload is larger than the buffer.
+   *
+   * Usage instructions:
+   * - Instantiate before any node is setup.
+   * - Call subscribe() in on_setup-method of node or after node setup is completed.
+   * - The callback is called once per complete payload.
+   *   The payload is only valid within the callback, as the buffer is reused for the next transfer.
+  */
+  class StreamSubscriber
+  {
+    public:
+      /**
+       * Message type carrying the chunks
+      */
+      using MessageType = std_msgs__msg__UInt8MultiArray;
+      /**
+       * Function-pointer type of callback function used by this subscriber
+      */
+      using CallbackType = void(*)(
+        const uint8_t* payload,
+        size_t size
+      );
+
+      /**
+       * Amount of executor handles needed by this subscriber
+      */
+      static constexpr unsigned int HANDLE_COUNT = Subscriber<MessageType>::HANDLE_COUNT;
+
+      /**
+       * Maximum length of the received dimension label, including null-termination
+      */
+      static constexpr size_t DIMENSION_LABEL_CAPACITY = 16;
+    private:
+      /**
+       * Subscriber of the chunks
+      */
+      Subscriber<MessageType> _subscriber;
+      /**
+       * Callback function called once per complete payload
+      */
+      const CallbackType _callback;
+      /**
+       * Preallocated buffer the payloads are reassembled in
+      */
+      uint8_t* const _buffer;
+      /**
+       * Size of the buffer in bytes
+      */
+      const size_t _capacity;
+      /**
+       * Preallocated layout dimension
+      */
+      std_msgs__msg__MultiArrayDimension _dimension;
+      /**
+       * Preallocated memory for the label of the layout dimension
+      */
+      char _dimension_label[DIMENSION_LABEL_CAPACITY];
+      /**
+       * true if a transfer is being reassembled
+      */
+      bool _is_receiving = false;
+      /**
+       * Id of current transfer
+      */
+      uint32_t _transfer_id = 0;
+      /**
+       * Size of the payload of current transfer in bytes
+      */
+      size_t _transfer_size = 0;
+      /**
+       * Amount of bytes of current transfer received so far, which is also the offset of the next chunk
+      */
+      size_t _received = 0;
+      /**
+       * Amount of transfers dropped
+      */
+      uint32_t _dropped_count = 0;
+
+    public:
+      /**
+       * Subscriber reassembling the payloads published in chunks by a @see{StreamPublisher}.
+       *
+       * Usage instructions:
+       * - Instantiate before any node is setup.
+       * - Call subscribe() in on_setup-method of node or after node setup is completed.
+       * @param node Pointer to node owning the subscriber
+       * @param topic_name Topic name (slash and namespace of node is appended later)
+       * @param buffer Preallocated buffer the payloads are reassembled in, must outlive the subscriber
+       * @param capacity Size of the buffer in bytes, which limits the payload size
+       * @param callback Pointer to callback-function called once per complete payload
+      */
+      StreamSubscriber(
+        Node* node,
+        const char* topic_name,
+        uint8_t* buffer,
+        size_t capacity,
+        CallbackType callback
+      ) noexcept;
+
+      /**
+       * Initializes the subscriber, and then subscribes to the topic on the ROS2 network.
+       * Node must be successfully initialized for this to succeed.
+       * @return true if success
+      */
+      bool subscribe(rclc_executor_handle_invocation_t invocation = ON_NEW_DATA) noexcept;
+
+      /**
+       * Sets the priority class of the subscriber, see @see{Handle::set_priority}
+       * @param priority Priority class
+      */
+      void set_priority(Priority priority) noexcept;
+
+      /**
+       * Returns true if a transfer is being reassembled
+      */
+      bool is_receiving(void) const noexcept;
+      /**
+       * Retrieves the amount of transfers dropped, due to missing chunks or payloads larger than the buffer
+       * @return Amount of transfers
+      */
+      uint32_t get_dropped_count(void) const noexcept;
+    private:
+      /**
+       * Callback of the chunk subscriber
+       * @param message Received chunk
+       * @param context Pointer to the stream subscriber
+      */
+      static void on_chunk(const MessageType* message, void* context) noexcept;
+      /**
+       * Places a received chunk in the buffer, and calls the callback when the payload is complete
+       * @param message Received chunk
+      */
+      void receive(const MessageType& message) noexcept;
+      /**
+       * Drops the current transfer, if any
+      */
+      void drop(void) noexcept;
+      /**
+       * Points the message memory at the place in the buffer where the next chunk is expected
+      */
+      void prepare_next(void) noexcept;
+  };
+}
\ No newline at end of file
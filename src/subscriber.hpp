@@ -7,11 +7,18 @@
 #include <rclc/executor.h>
 
 #include "message.hpp"
+#include "serialization.hpp"
 #include "node.hpp"
 #include "handle.hpp"
+#include "topic_statistics.hpp"
+#include "latency_probe.hpp"
+#include "coroutine.hpp"
 
 namespace rclc_cppb
 {
+  template<typename _MessageType>
+  class LocalSubscriber;
+
   /**
    * ROS2 subscriber designed to be similar to the Subscriber class in rclcpp.
    * 
@@ -21,6 +28,7 @@ namespace rclc_cppb
    * - Instantiate before any node is setup.
    * - Call subscribe() in on_setup-method of node or after node setup is completed.
    * - Message type must have Message trait implemented on it.
+   * - To receive from publishers on the same device directly, use @see{LocalSubscriber} instead.
    * @param <_MessageType> Message type handled by subscriber
   */
   template<typename _MessageType>
@@ -48,6 +56,18 @@ namespace rclc_cppb
       using CallbackType = void(*)(
         const MessageType* message
       );
+      /**
+       * Function-pointer type of callback function with context used by this subscriber
+      */
+      using ContextCallbackType = void(*)(
+        const MessageType* message,
+        void* context
+      );
+
+      /**
+       * Amount of executor handles needed by this subscriber
+      */
+      static constexpr unsigned int HANDLE_COUNT = 1;
     public:
       /**
        * Topic name
@@ -58,6 +78,14 @@ namespace rclc_cppb
        * Callback function used by this subscriber
       */
       CallbackType _callback;
+      /**
+       * Callback function with context used by this subscriber, if given instead of a plain callback
+      */
+      ContextCallbackType _context_callback;
+      /**
+       * Context passed to the callback function with context
+      */
+      void* _context;
       /**
        * Message
       */
@@ -66,6 +94,22 @@ namespace rclc_cppb
        * rclc subscription entity
       */
       rcl_subscription_t _subscription;
+      /**
+       * Number of messages received, wrapping around
+      */
+      uint32_t _receive_count = 0;
+      /**
+       * Statistics recorded for each received message, or NULL if untracked
+      */
+      TopicStatistics* _statistics = NULL;
+      /**
+       * Histogram of the one-way latency of each received message, or NULL if not probed
+      */
+      LatencyHistogram* _latency_histogram = NULL;
+      /**
+       * Invocation of the callback, kept to subscribe again after the session to the agent was restored
+      */
+      rclc_executor_handle_invocation_t _invocation = ON_NEW_DATA;
       /**
        * Stage of initialization for this subscriber
       */
@@ -82,12 +126,29 @@ namespace rclc_cppb
        * @param <_MessageType> Message type handled by subscriber
        * @param node Pointer to node owning the subscriber
        * @param topic_name Topic name (slash and namespace of node is appended later)
-       * @param callback Pointer to callback-function used by this subscriber
+       * @param callback Pointer to callback-function used by this subscriber, or NULL if messages are only awaited
       */
       Subscriber(Node* node, const char* topic_name, CallbackType callback) noexcept;
+      /**
+       * ROS2 subscriber designed to be similar to the Subscriber class in rclcpp.
+       * 
+       * Usage instructions:
+       * - Instantiate before any node is setup
+       * - Call subscribe() in on_setup-method of node or after node setup is completed
+       * - Message type must have Message trait implemented on it
+       * @param <_MessageType> Message type handled by subscriber
+       * @param node Pointer to node owning the subscriber
+       * @param topic_name Topic name (slash and namespace of node is appended later)
+       * @param callback Pointer to callback-function used by this subscriber
+       * @param context Context passed to the callback-function along with each message
+      */
+      Subscriber(Node* node, const char* topic_name, ContextCallbackType callback, void* context) noexcept;
 
       ~Subscriber() noexcept;
 
+      using Handle::set_priority;
+      using Handle::get_priority;
+
       /**
        * Initializes the subscriber, and then subscribes to the topic on the ROS2 network.
        * Node must be successfully initialized for this to succeed.
@@ -95,11 +156,69 @@ namespace rclc_cppb
       */
       bool subscribe(rclc_executor_handle_invocation_t invocation = ON_NEW_DATA) noexcept;
       
+      /**
+       * Sets message data.
+       * For message types containing sequences, this is how preallocated memory is handed to the subscriber.
+       * Must then be called before subscribing.
+       * @param data Message data
+      */
+      void set_data(DataType data) noexcept;
       /**
        * Retrieves last received message data as reference
        * @return Reference to message data
       */
       DataRef get_last_data(void) noexcept;
+      /**
+       * Tracks statistics of the received messages, see @see{TopicStatistics}
+       * @param statistics Pointer to statistics, or NULL to stop tracking
+      */
+      void set_statistics(TopicStatistics* statistics) noexcept;
+      /**
+       * Probes the one-way latency of each received message, from its header timestamp to the time of receipt,
+       * both read from the epoch clock synchronized with the agent, see @see{Clock}.
+       * Publishers must stamp their messages, see @see{Publisher::set_latency_probe}.
+       * Nothing is recorded until the clock is synchronized, or for messages which are not stamped.
+       * The message type must carry a std_msgs/Header.
+       * @param histogram Pointer to histogram recording the latencies, or NULL to stop probing
+      */
+      void set_latency_probe(LatencyHistogram* histogram) noexcept;
+
+      #ifdef RCLC_CPPB_COROUTINES
+        /**
+         * Awaits the next message within a coroutine, see @see{Task}.
+         * The callback, if any, still runs first.
+         * @param timeout_ns Maximum time to wait in nanoseconds
+         * @return Awaitable resuming with a pointer to the message, valid until the next spin, or NULL on timeout
+        */
+        ReceiveAwaitable<MessageType> next(
+          uint64_t timeout_ns = ReceiveAwaitable<MessageType>::NO_TIMEOUT
+        ) noexcept;
+      #endif
+    private:
+      /**
+       * Counts a received message, then calls the callback. Called by the executor.
+       * @param message Received message
+       * @param context Pointer to the subscriber
+      */
+      static void on_message(const void* message, void* context) noexcept;
+      /**
+       * Records the message in the statistics and latency histogram, if any, then calls the callback, if any
+       * @param message Received message
+      */
+      void run_callback(const MessageType* message) const noexcept;
+    protected:
+      /**
+       * Finalizes the subscription after the session to the agent was lost
+       * @return true if it had been subscribed
+      */
+      bool on_session_lost(void) noexcept override;
+      /**
+       * Subscribes again after the session to the agent was restored
+       * @return true if success
+      */
+      bool on_session_restored(void) noexcept override;
+
+      friend class LocalSubscriber<_MessageType>;
   };
 }
 
@@ -3,6 +3,7 @@
 #include "subscriber.hpp"
 
 #include "error.hpp"
+#include "trace.hpp"
 
 //https://micro.ros.org/docs/tutorials/programming_rcl_rclc/pub_sub/
 
@@ -14,9 +15,27 @@ namespace rclc_cppb
     const char* const topic_name,
     CallbackType callback
   ) noexcept:
-    Handle(node),
+    Handle(node, Subscriber::HANDLE_COUNT),
     topic_name(topic_name),
-    _callback(callback)
+    _callback(callback),
+    _context_callback(NULL),
+    _context(NULL)
+  {
+    
+  }
+
+  template<typename _MessageType>
+  Subscriber<_MessageType>::Subscriber(
+    Node* node,
+    const char* const topic_name,
+    ContextCallbackType callback,
+    void* context
+  ) noexcept:
+    Handle(node, Subscriber::HANDLE_COUNT),
+    topic_name(topic_name),
+    _callback(NULL),
+    _context_callback(callback),
+    _context(context)
   {
     
   }
@@ -40,6 +59,7 @@ namespace rclc_cppb
   {
     using InitStage = Subscriber<MessageType>::InitStage;
 
+    this->_invocation = invocation;
     static_assert(InitStage::NEW < InitStage::INIT_DONE);
     if(this->_init_stage < InitStage::INIT_DONE)
     {
@@ -71,13 +91,14 @@ namespace rclc_cppb
     {
       if(
         !rclc_cppb::error::handled_call<
-          decltype(&rclc_executor_add_subscription),
-          &rclc_executor_add_subscription
+          decltype(&rclc_executor_add_subscription_with_context),
+          &rclc_executor_add_subscription_with_context
         >(
           Handle::get_executor_mut(),
           &this->_subscription,
           &this->_message,
-          (rclc_subscription_callback_t)this->_callback,
+          &Subscriber::on_message,
+          this,
           invocation
         )
       )
@@ -85,16 +106,109 @@ namespace rclc_cppb
         return false;
       }
       this->_init_stage = InitStage::EXECUTOR_DONE;
+      this->on_executor_added(&this->_subscription);
       
-      Node::spin_once();
+      Node::spin_once(0);
     }
     return true;
   }
-  
+
+  template<typename _MessageType>
+  void Subscriber<_MessageType>::set_data(DataType data) noexcept
+  {
+    Message<MessageType>::set_data(this->_message, data);
+  }
   template<typename _MessageType>
   typename Message<_MessageType>::DataRef
     Subscriber<_MessageType>::get_last_data(void) noexcept
   {
     return Message<MessageType>::get_data(this->_message);
   }
+
+  template<typename _MessageType>
+  void Subscriber<_MessageType>::set_statistics(TopicStatistics* statistics) noexcept
+  {
+    if(statistics != NULL)
+    {
+      statistics->attach(this->topic_name);
+    }
+    this->_statistics = statistics;
+  }
+
+  template<typename _MessageType>
+  void Subscriber<_MessageType>::set_latency_probe(LatencyHistogram* histogram) noexcept
+  {
+    static_assert(latency::IsStamped<MessageType>::value, "Message type must carry a std_msgs/Header!");
+
+    this->_latency_histogram = histogram;
+  }
+
+  #ifdef RCLC_CPPB_COROUTINES
+    template<typename _MessageType>
+    ReceiveAwaitable<_MessageType> Subscriber<_MessageType>::next(uint64_t timeout_ns) noexcept
+    {
+      return ReceiveAwaitable<MessageType>(
+        &this->_receive_count,
+        this->_receive_count,
+        &this->_message,
+        timeout_ns
+      );
+    }
+  #endif
+
+  template<typename _MessageType>
+  void Subscriber<_MessageType>::on_message(const void* message, void* context) noexcept
+  {
+    Subscriber* subscriber = (Subscriber*)context;
+    subscriber->_receive_count++;
+    subscriber->run_callback((const MessageType*)message);
+  }
+
+  template<typename _MessageType>
+  void Subscriber<_MessageType>::run_callback(const MessageType* message) const noexcept
+  {
+    if(this->_statistics != NULL)
+    {
+      this->_statistics->record(TopicStatistics::get_message_size(*message));
+    }
+    if constexpr(latency::IsStamped<MessageType>::value)
+    {
+      if(this->_latency_histogram != NULL && Clock::is_synced())
+      {
+        const int64_t stamp_ns = latency::get_stamp_ns(*message);
+        if(stamp_ns != 0)
+        {
+          this->_latency_histogram->record(Clock::now_ns() - stamp_ns);
+        }
+      }
+    }
+    RCLC_CPPB_TRACE(CALLBACK_BEGIN, this->topic_name, 0);
+    if(this->_context_callback != NULL)
+    {
+      this->_context_callback(message, this->_context);
+    }
+    else if(this->_callback != NULL)
+    {
+      this->_callback(message);
+    }
+    RCLC_CPPB_TRACE(CALLBACK_END, this->topic_name, 0);
+  }
+
+  template<typename _MessageType>
+  bool Subscriber<_MessageType>::on_session_lost(void) noexcept
+  {
+    if(this->_init_stage < InitStage::INIT_DONE)
+    {
+      return false;
+    }
+    this->_init_stage = InitStage::NEW;
+    // Errors are expected, as the agent is gone
+    (void)rcl_subscription_fini(&this->_subscription, this->get_node_handle_mut());
+    return true;
+  }
+  template<typename _MessageType>
+  bool Subscriber<_MessageType>::on_session_restored(void) noexcept
+  {
+    return this->subscribe(this->_invocation);
+  }
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * Threading support, which is only available on host builds.
+ *
+ * On Linux, RCLC_CPPB_THREADS is defined unless RCLC_CPPB_NO_THREADS is,
+ * which enables threaded nodes (see @see{Node::set_threaded}) and locking of publishers.
+ * Either macro must be defined for the whole build, as it changes the layout of classes.
+ * On MCUs the mutex and lock below are empty and compile away.
+*/
+#if defined(__linux__) && !defined(RCLC_CPPB_NO_THREADS)
+  #define RCLC_CPPB_THREADS
+#endif
+
+#include <stdint.h>
+
+#ifdef RCLC_CPPB_THREADS
+  #include <mutex>
+  #include <thread>
+  #include <atomic>
+#endif
+
+namespace rclc_cppb::threading
+{
+  #ifdef RCLC_CPPB_THREADS
+    /**
+     * Mutual exclusion between threads
+    */
+    using Mutex = std::mutex;
+    /**
+     * Holds a mutex locked for as long as it lives
+    */
+    using Lock = std::lock_guard<std::mutex>;
+    /**
+     * Mutual exclusion between threads, which the owning thread may lock again
+    */
+    using RecursiveMutex = std::recursive_mutex;
+    /**
+     * Holds a recursive mutex locked for as long as it lives
+    */
+    using RecursiveLock = std::lock_guard<std::recursive_mutex>;
+    /**
+     * Counter which may be incremented from several threads
+    */
+    using Counter = std::atomic<uint32_t>;
+    /**
+     * Flag which may be set from another thread
+    */
+    using Flag = std::atomic<bool>;
+  #else
+    /**
+     * Mutual exclusion between threads, which does nothing without threads
+    */
+    struct Mutex {};
+    /**
+     * Holds a mutex locked for as long as it lives, which does nothing without threads
+    */
+    struct Lock
+    {
+      explicit Lock(Mutex&) noexcept {}
+    };
+    /**
+     * Mutual exclusion between threads, which the owning thread may lock again, and which does nothing without threads
+    */
+    struct RecursiveMutex {};
+    /**
+     * Holds a recursive mutex locked for as long as it lives, which does nothing without threads
+    */
+    struct RecursiveLock
+    {
+      explicit RecursiveLock(RecursiveMutex&) noexcept {}
+    };
+    /**
+     * Counter which may be incremented from several threads, which is plain without threads
+    */
+    using Counter = uint32_t;
+    /**
+     * Flag which may be set from an interrupt, which is volatile without threads
+    */
+    using Flag = volatile bool;
+  #endif
+
+  /**
+   * Retrieves the mutex serializing all spins, since every executor shares the one XRCE session, which is not thread-safe.
+   * Also guards the intrusive lists of nodes, handles and spin hooks.
+   * Recursive, as spin hooks may publish, which spins again.
+   * Constructed on first use, so that global entities may lock it while being constructed.
+   * @return Spin mutex
+  */
+  inline RecursiveMutex& get_spin_mutex(void) noexcept
+  {
+    static RecursiveMutex spin_mutex;
+    return spin_mutex;
+  }
+}
\ No newline at end of file
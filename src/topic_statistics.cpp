@@ -0,0 +1,143 @@
+#include "topic_statistics.hpp"
+
+#include <Arduino.h>
+#include <rosidl_typesupport_microxrcedds_c/identifier.h>
+#include <rosidl_typesupport_microxrcedds_c/message_type_support.h>
+
+namespace rclc_cppb
+{
+  TopicStatistics* TopicStatistics::_first = NULL;
+
+  TopicStatistics::TopicStatistics(Node* node) noexcept:
+    _next(TopicStatistics::_first),
+    node(node),
+    _window_start_us(micros())
+  {
+    TopicStatistics::_first = this;
+  }
+  TopicStatistics::~TopicStatistics() noexcept
+  {
+    for(TopicStatistics** statistics = &TopicStatistics::_first; *statistics != NULL; statistics = &(*statistics)->_next)
+    {
+      if(*statistics == this)
+      {
+        *statistics = this->_next;
+        break;
+      }
+    }
+  }
+
+  void TopicStatistics::record(size_t byte_count) noexcept
+  {
+    const unsigned long now_us = micros();
+    threading::Lock lock(this->_mutex);
+
+    if(this->_total_count > 0)
+    {
+      const unsigned long period_us = now_us - this->_last_us;
+      if(this->_period_count == 0 || period_us < this->_min_period_us)
+      {
+        this->_min_period_us = period_us;
+      }
+      if(period_us > this->_max_period_us)
+      {
+        this->_max_period_us = period_us;
+      }
+      this->_period_sum_us += period_us;
+      this->_period_count++;
+
+      if(this->_total_count > 1)
+      {
+        // J += (|D| - J)/16, with J kept scaled by 16
+        const unsigned long deviation_us = period_us > this->_last_period_us ?
+          period_us - this->_last_period_us :
+          this->_last_period_us - period_us;
+        this->_jitter_x16_us += deviation_us - (this->_jitter_x16_us >> 4);
+      }
+      this->_last_period_us = period_us;
+    }
+    this->_last_us = now_us;
+    this->_total_count++;
+    this->_message_count++;
+    this->_byte_count += (uint32_t)byte_count;
+  }
+
+  TopicStats TopicStatistics::get_stats(void) const noexcept
+  {
+    const unsigned long now_us = micros();
+    threading::Lock lock(this->_mutex);
+
+    TopicStats stats = {};
+    stats.message_count = this->_message_count;
+    stats.byte_count = this->_byte_count;
+    const unsigned long window_us = now_us - this->_window_start_us;
+    if(window_us > 0)
+    {
+      stats.rate_hz = this->_message_count*1000000.0f/window_us;
+      stats.bandwidth_bps = this->_byte_count*1000000.0f/window_us;
+    }
+    if(this->_period_count > 0)
+    {
+      stats.min_period_us = this->_min_period_us;
+      stats.avg_period_us = (unsigned long)(this->_period_sum_us/this->_period_count);
+      stats.max_period_us = this->_max_period_us;
+    }
+    stats.jitter_us = this->_jitter_x16_us >> 4;
+    return stats;
+  }
+
+  void TopicStatistics::reset(void) noexcept
+  {
+    const unsigned long now_us = micros();
+    threading::Lock lock(this->_mutex);
+
+    this->_window_start_us = now_us;
+    this->_message_count = 0;
+    this->_byte_count = 0;
+    this->_period_count = 0;
+    this->_period_sum_us = 0;
+    this->_min_period_us = 0;
+    this->_max_period_us = 0;
+  }
+
+  const char* TopicStatistics::get_topic_name(void) const noexcept
+  {
+    return this->_topic_name;
+  }
+
+  TopicStatistics* TopicStatistics::get_first(void) noexcept
+  {
+    return TopicStatistics::_first;
+  }
+  TopicStatistics* TopicStatistics::get_next(void) const noexcept
+  {
+    return this->_next;
+  }
+
+  void TopicStatistics::attach(const char* topic_name) noexcept
+  {
+    this->_topic_name = topic_name;
+  }
+
+  size_t TopicStatistics::get_serialized_size(
+    const rosidl_message_type_support_t* type_support,
+    const void* message
+  ) noexcept
+  {
+    if(type_support == NULL)
+    {
+      return 0;
+    }
+    // The type-support may be a dispatcher over several type-supports, of which micro-ROS serializes with its own
+    const rosidl_message_type_support_t* handle = get_message_typesupport_handle(
+      type_support,
+      ROSIDL_TYPESUPPORT_MICROXRCEDDS_C__IDENTIFIER_VALUE
+    );
+    if(handle == NULL)
+    {
+      return 0;
+    }
+    const message_type_support_callbacks_t* callbacks = (const message_type_support_callbacks_t*)handle->data;
+    return callbacks->get_serialized_size(message);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "message.hpp"
+#include "node.hpp"
+#include "serialization.hpp"
+#include "threading.hpp"
+
+namespace rclc_cppb
+{
+  template<typename _MessageType>
+  class Publisher;
+  template<typename _MessageType>
+  class Subscriber;
+
+  /**
+   * Snapshot of the statistics of a topic, see @see{TopicStatistics::get_stats}
+  */
+  struct TopicStats
+  {
+    /**
+     * Amount of messages in the window
+    */
+    uint32_t message_count;
+    /**
+     * Amount of serialized bytes in the window
+    */
+    uint32_t byte_count;
+    /**
+     * Messages per second over the window
+    */
+    float rate_hz;
+    /**
+     * Serialized bytes per second over the window
+    */
+    float bandwidth_bps;
+    /**
+     * Shortest time in microseconds between two messages in the window, zero if none
+    */
+    unsigned long min_period_us;
+    /**
+     * Average time in microseconds between two messages in the window, zero if none
+    */
+    unsigned long avg_period_us;
+    /**
+     * Longest time in microseconds between two messages in the window, zero if none
+    */
+    unsigned long max_period_us;
+    /**
+     * Running estimate of the inter-arrival jitter in microseconds, as in RFC 3550
+    */
+    unsigned long jitter_us;
+  };
+
+  /**
+   * Running statistics of the messages of one publisher or subscriber:
+   * rate, bandwidth, min/avg/max period and inter-arrival jitter.
+   * Fixed-size, so that no heap allocation takes place.
+   *
+   * Statistics cover a window, which starts on construction and on every @see{reset}.
+   * Only the jitter carries over between windows, as it is a running estimate.
+   *
+   * Usage instructions:
+   * - Instantiate one per publisher or subscriber to track, and hand it to set_statistics() of that entity.
+   * - Read with @see{get_stats}, or publish the statistics of all entities of a node with @see{StatisticsPublisher}.
+  */
+  class TopicStatistics
+  {
+    private:
+      /**
+       * First topic statistics in the list
+      */
+      static TopicStatistics* _first;
+      /**
+       * Next topic statistics in the list
+      */
+      TopicStatistics* _next;
+    public:
+      /**
+       * Node owning the tracked entity
+      */
+      Node* const node;
+    private:
+      /**
+       * Topic name of the tracked entity, or NULL while not attached
+      */
+      const char* _topic_name = NULL;
+      /**
+       * Time when the window started, in microseconds
+      */
+      unsigned long _window_start_us;
+      /**
+       * Time of the last message, in microseconds
+      */
+      unsigned long _last_us = 0;
+      /**
+       * Last time in microseconds between two messages
+      */
+      unsigned long _last_period_us = 0;
+      /**
+       * Amount of messages ever recorded, used to tell whether there are previous periods
+      */
+      uint32_t _total_count = 0;
+      /**
+       * Amount of messages in the window
+      */
+      uint32_t _message_count = 0;
+      /**
+       * Amount of serialized bytes in the window
+      */
+      uint32_t _byte_count = 0;
+      /**
+       * Amount of periods in the window
+      */
+      uint32_t _period_count = 0;
+      /**
+       * Sum of periods in the window, in microseconds
+      */
+      uint64_t _period_sum_us = 0;
+      /**
+       * Shortest period in the window, in microseconds
+      */
+      unsigned long _min_period_us = 0;
+      /**
+       * Longest period in the window, in microseconds
+      */
+      unsigned long _max_period_us = 0;
+      /**
+       * Jitter estimate in microseconds, scaled by 16 to keep precision in integer arithmetic
+      */
+      unsigned long _jitter_x16_us = 0;
+      /**
+       * Guards the statistics against being recorded and read from several threads at once
+      */
+      mutable threading::Mutex _mutex;
+
+    public:
+      /**
+       * Running statistics of the messages of one publisher or subscriber.
+       * Adds itself to the list of topic statistics.
+       * @param node Pointer to node owning the tracked entity
+      */
+      explicit TopicStatistics(Node* node) noexcept;
+      TopicStatistics(const TopicStatistics&) = delete;
+      /**
+       * Removes itself from the list of topic statistics
+      */
+      ~TopicStatistics() noexcept;
+
+      /**
+       * Records a message
+       * @param byte_count Serialized size of the message in bytes
+      */
+      void record(size_t byte_count) noexcept;
+      /**
+       * Retrieves a snapshot of the statistics of the current window
+       * @return Statistics
+      */
+      TopicStats get_stats(void) const noexcept;
+      /**
+       * Starts a new window
+      */
+      void reset(void) noexcept;
+      /**
+       * Retrieves the topic name of the tracked entity
+       * @return Topic name, or NULL while not attached to an entity
+      */
+      const char* get_topic_name(void) const noexcept;
+
+      /**
+       * Retrieves the first topic statistics in the list, to iterate all of them
+       * @return Pointer to topic statistics, or NULL if none
+      */
+      static TopicStatistics* get_first(void) noexcept;
+      /**
+       * Retrieves the next topic statistics in the list
+       * @return Pointer to topic statistics, or NULL if last
+      */
+      TopicStatistics* get_next(void) const noexcept;
+    private:
+      /**
+       * Attaches to an entity, called by set_statistics() of the entity
+       * @param topic_name Topic name of the entity
+      */
+      void attach(const char* topic_name) noexcept;
+      /**
+       * Retrieves the serialized size of a message: constant for message types with the FixedLayout trait implemented,
+       * otherwise computed by the type-support, counting the contents of strings and sequences
+       * @param message Message
+       * @return Size in bytes
+      */
+      template<typename _MessageType>
+      static size_t get_message_size(const _MessageType& message) noexcept;
+      /**
+       * Computes the serialized size of a message with the callbacks of its micro-ROS type-support
+       * @param type_support Type-support of the message type
+       * @param message Message
+       * @return Size in bytes, or 0 if the type-support does not provide it
+      */
+      static size_t get_serialized_size(const rosidl_message_type_support_t* type_support, const void* message) noexcept;
+
+      template<typename _MessageType>
+      friend class Publisher;
+      template<typename _MessageType>
+      friend class Subscriber;
+  };
+}
+
+#include "topic_statistics_impl.hpp"
\ No newline at end of file
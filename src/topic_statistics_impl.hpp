@@ -0,0 +1,20 @@
+#pragma once
+
+#include "topic_statistics.hpp"
+
+namespace rclc_cppb
+{
+  template<typename _MessageType>
+  size_t TopicStatistics::get_message_size(const _MessageType& message) noexcept
+  {
+    if constexpr(FixedLayout<_MessageType>::IS_IMPL)
+    {
+      (void)message;
+      return FixedLayout<_MessageType>::SERIALIZED_SIZE;
+    }
+    else
+    {
+      return TopicStatistics::get_serialized_size(Message<_MessageType>::get_type_support(), &message);
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "trace.hpp"
+
+#ifdef RCLC_CPPB_TRACING
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "threading.hpp"
+#include "error.hpp"
+
+#if defined(__linux__)
+  #include <unistd.h>
+#endif
+
+namespace rclc_cppb::trace
+{
+  static constexpr size_t LINE_SIZE = 192;
+
+  Event _events[RCLC_CPPB_TRACE_BUFFER_SIZE];
+  size_t _next_index = 0;
+  size_t _count = 0;
+  uint32_t _dropped_count = 0;
+  threading::Mutex _mutex;
+
+  #ifdef RCLC_CPPB_THREADS
+    std::atomic<uint8_t> _thread_count{0};
+  #endif
+
+  /**
+   * Retrieves the index of the calling thread, assigned on its first event
+  */
+  static uint8_t get_thread_index(void) noexcept
+  {
+    #ifdef RCLC_CPPB_THREADS
+      thread_local const uint8_t index = _thread_count++;
+      return index;
+    #else
+      return 0;
+    #endif
+  }
+
+  void record(EventType type, const char* name, int32_t arg) noexcept
+  {
+    const uint8_t thread = get_thread_index();
+    threading::Lock lock(_mutex);
+    Event& event = _events[_next_index];
+    // Read under the lock, so that the events are in order of time
+    event.time_us = (uint32_t)micros();
+    event.arg = arg;
+    event.name = name;
+    event.type = type;
+    event.thread = thread;
+    _next_index = (_next_index + 1) % RCLC_CPPB_TRACE_BUFFER_SIZE;
+    if(_count < RCLC_CPPB_TRACE_BUFFER_SIZE)
+    {
+      _count++;
+    }
+    else
+    {
+      _dropped_count++;
+    }
+  }
+
+  size_t get_count(void) noexcept
+  {
+    threading::Lock lock(_mutex);
+    return _count;
+  }
+  uint32_t get_dropped_count(void) noexcept
+  {
+    threading::Lock lock(_mutex);
+    return _dropped_count;
+  }
+
+  bool get_event(size_t index, Event* event) noexcept
+  {
+    threading::Lock lock(_mutex);
+    if(index >= _count)
+    {
+      return false;
+    }
+    *event = _events[(_next_index + RCLC_CPPB_TRACE_BUFFER_SIZE - _count + index) % RCLC_CPPB_TRACE_BUFFER_SIZE];
+    return true;
+  }
+
+  void clear(void) noexcept
+  {
+    threading::Lock lock(_mutex);
+    _next_index = 0;
+    _count = 0;
+    _dropped_count = 0;
+  }
+
+  void dump(WriteCallback write, void* context) noexcept
+  {
+    #if defined(__linux__)
+      const long pid = (long)getpid();
+    #else
+      const long pid = 1;
+    #endif
+    char line[LINE_SIZE];
+    write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", context);
+
+    // Times are unwrapped, as micros() wraps around every 71 minutes
+    uint64_t time_us = 0;
+    uint32_t previous_us = 0;
+    Event event;
+    for(size_t i = 0; get_event(i, &event); i++)
+    {
+      time_us = i == 0 ? event.time_us : time_us + (uint32_t)(event.time_us - previous_us);
+      previous_us = event.time_us;
+
+      size_t name_length;
+      const char* name;
+      if(event.type == EventType::ERROR)
+      {
+        name = error::get_function_name(event.name, &name_length);
+      }
+      else
+      {
+        name = event.name;
+        name_length = strlen(name);
+      }
+      const char* phase;
+      const char* category;
+      switch(event.type)
+      {
+        case EventType::SPIN_BEGIN: phase = "B"; category = "spin"; break;
+        case EventType::SPIN_END: phase = "E"; category = "spin"; break;
+        case EventType::PUBLISH_BEGIN: phase = "B"; category = "publish"; break;
+        case EventType::PUBLISH_END: phase = "E"; category = "publish"; break;
+        case EventType::CALLBACK_BEGIN: phase = "B"; category = "callback"; break;
+        case EventType::CALLBACK_END: phase = "E"; category = "callback"; break;
+        default: phase = "i"; category = "error"; break;
+      }
+      snprintf(
+        line,
+        sizeof(line),
+        "%s\n{\"name\":\"%.*s\",\"cat\":\"%s\",\"ph\":\"%s\",%s\"ts\":%llu,\"pid\":%ld,\"tid\":%u,\"args\":{\"arg\":%ld}}",
+        i == 0 ? "" : ",",
+        (int)name_length,
+        name,
+        category,
+        phase,
+        event.type == EventType::ERROR ? "\"s\":\"t\"," : "",
+        (unsigned long long)time_us,
+        pid,
+        (unsigned int)event.thread,
+        (long)event.arg
+      );
+      write(line, context);
+    }
+    write("\n]}\n", context);
+  }
+
+  #if defined(__linux__)
+    bool export_chrome_trace(const char* path) noexcept
+    {
+      FILE* file = fopen(path, "w");
+      if(file == NULL)
+      {
+        return false;
+      }
+      dump([](const char* text, void* context)
+      {
+        fputs(text, (FILE*)context);
+      }, file);
+      return fclose(file) == 0;
+    }
+  #endif
+}
+
+#endif
\ No newline at end of file
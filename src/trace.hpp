@@ -0,0 +1,125 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Tracing of library events: spins, publishes, callback dispatch and failed rcl calls.
+ *
+ * Tracing is compiled in only if RCLC_CPPB_TRACING is defined for the whole build.
+ * Otherwise the trace points expand to nothing, and their arguments are not even evaluated.
+ * Events are kept in a ring buffer in RAM, overwriting the oldest ones, and can be dumped as Chrome trace JSON
+ * to be opened in Perfetto or chrome://tracing. Dumps of several processes or boards can be opened together.
+ *
+ * The ring buffer holds RCLC_CPPB_TRACE_BUFFER_SIZE events of 16 bytes each on MCUs.
+*/
+#ifndef RCLC_CPPB_TRACE_BUFFER_SIZE
+  #if defined(__linux__)
+    #define RCLC_CPPB_TRACE_BUFFER_SIZE 16384
+  #else
+    #define RCLC_CPPB_TRACE_BUFFER_SIZE 256
+  #endif
+#endif
+
+#ifdef RCLC_CPPB_TRACING
+  #define RCLC_CPPB_TRACE(TYPE, NAME, ARG) \
+    ::rclc_cppb::trace::record(::rclc_cppb::trace::EventType::TYPE, (NAME), (int32_t)(ARG))
+#else
+  // The argument is not evaluated, only kept from being reported as unused
+  #define RCLC_CPPB_TRACE(TYPE, NAME, ARG) ((void)sizeof(ARG))
+#endif
+
+namespace rclc_cppb::trace
+{
+  /**
+   * Type of a traced event
+  */
+  enum class EventType: uint8_t
+  {
+    SPIN_BEGIN = 0,
+    SPIN_END = 1,
+    PUBLISH_BEGIN = 2,
+    PUBLISH_END = 3,
+    CALLBACK_BEGIN = 4,
+    CALLBACK_END = 5,
+    ERROR = 6
+  };
+
+  /**
+   * Traced event, as kept in the ring buffer
+  */
+  struct Event
+  {
+    /**
+     * Time of the event in microseconds, see micros()
+    */
+    uint32_t time_us;
+    /**
+     * Argument of the event: the result of a spin or publish, or the return code of a failed call
+    */
+    int32_t arg;
+    /**
+     * Name of the event: the topic or service name, or the failed function.
+     * Must point to a string outliving the trace.
+    */
+    const char* name;
+    /**
+     * Type of the event
+    */
+    EventType type;
+    /**
+     * Index of the thread the event took place on, 0 without threads
+    */
+    uint8_t thread;
+  };
+
+  /**
+   * Function-pointer type of the output of @see{dump}, e.g. one printing to Serial
+  */
+  using WriteCallback = void(*)(const char* text, void* context);
+
+  #ifdef RCLC_CPPB_TRACING
+    /**
+     * Records an event into the ring buffer. Use the RCLC_CPPB_TRACE macro instead,
+     * which compiles away without tracing.
+     * @param type Type of the event
+     * @param name Name of the event, which must outlive the trace
+     * @param arg Argument of the event
+    */
+    void record(EventType type, const char* name, int32_t arg) noexcept;
+    /**
+     * Retrieves the amount of events held by the ring buffer
+    */
+    size_t get_count(void) noexcept;
+    /**
+     * Retrieves the amount of events overwritten since the last clear, as the ring buffer was full
+    */
+    uint32_t get_dropped_count(void) noexcept;
+    /**
+     * Retrieves an event held by the ring buffer
+     * @param index Index of the event, 0 being the oldest
+     * @param event Pointer to where the event is written
+     * @return true if there is an event at given index
+    */
+    bool get_event(size_t index, Event* event) noexcept;
+    /**
+     * Removes all events from the ring buffer
+    */
+    void clear(void) noexcept;
+    /**
+     * Writes all events held by the ring buffer as Chrome trace JSON, oldest first, in pieces of text.
+     * Events keep being recorded meanwhile, so dump when the system is quiet.
+     * @param write Pointer to the function given each piece of text
+     * @param context Context passed to the write function
+    */
+    void dump(WriteCallback write, void* context = NULL) noexcept;
+    #if defined(__linux__)
+      /**
+       * Writes all events held by the ring buffer as Chrome trace JSON into a file
+       * @param path Path of the file, which is overwritten
+       * @return true if success
+      */
+      bool export_chrome_trace(const char* path) noexcept;
+    #endif
+  #endif
+}
\ No newline at end of file